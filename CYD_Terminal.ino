@@ -17,6 +17,8 @@
 #include "keyboard.h"
 #include "utf8.h"
 #include "sdcard.h"
+#include "uartio.h"
+#include "benchmark.h"
 #include <Preferences.h>
 
 Preferences preferences;
@@ -26,6 +28,7 @@ bool keyboardVisible = false;
 bool inSetupMode = true;
 int selectedBaudRate = 4; // Default 115200
 int uartMode = 0; // 0 = USB, 1 = External
+int cellFont = TERMINAL_FONT; // CELL_FONT_6X8 or CELL_FONT_4X6
 bool sdAutoRecord = SD_AUTO_RECORD; // Auto-start recording
 
 // Button debounce
@@ -35,6 +38,8 @@ const unsigned long debounceDelay = 300;
 // Touch state for scrolling
 int lastTouchY = -1;
 bool isDragging = false;
+unsigned long lastDragTime = 0;
+float dragVelocity = 0;  // Smoothed finger speed in pixels per second, for the fling
 
 // RX/TX activity tracking
 unsigned long lastRxTime = 0;
@@ -47,6 +52,16 @@ int batteryPercent = 0;
 unsigned long lastBatteryUpdate = 0;
 const unsigned long batteryUpdateInterval = 5000; // Update every 5 seconds
 
+// Status bar: the state each widget last drew (-1 = not drawn yet), so a
+// widget only repaints its own rectangle when its state changes
+int shownBaud = -1;
+int shownRx = -1;
+int shownTx = -1;
+int shownRec = -1;
+int shownGrid = -1;
+int shownKeyboard = -1;
+int shownBattery = -1;
+
 void setup() {
   // CRITICAL: Initialize Serial FIRST for debugging
   Serial.begin(115200);
@@ -60,7 +75,8 @@ void setup() {
   // Load saved settings
   selectedBaudRate = preferences.getInt("baudrate", 4);
   uartMode = preferences.getInt("uartmode", 0);
-  Serial.printf("Loaded: BaudRate=%d, Mode=%d\n", selectedBaudRate, uartMode);
+  cellFont = preferences.getInt("font", TERMINAL_FONT);
+  Serial.printf("Loaded: BaudRate=%d, Mode=%d, Font=%d\n", selectedBaudRate, uartMode, cellFont);
   
   // Setup boot button
   pinMode(KEY_PIN, INPUT_PULLUP);
@@ -109,6 +125,9 @@ void loop() {
   // Feed watchdog to prevent resets
   yield();
   
+  int rxBytes = 0;
+  bool flinging = false;
+  
   // Check boot button
   if (digitalRead(KEY_PIN) == LOW) {
     unsigned long currentTime = millis();
@@ -145,19 +164,19 @@ void loop() {
     // Update battery status periodically
     if (millis() - lastBatteryUpdate > batteryUpdateInterval) {
       updateBattery();
-      drawStatusBar(); // Refresh status bar with new battery level and RX/TX
+      updateStatusBar(); // Repaints the battery widget if the level changed
       lastBatteryUpdate = millis();
     }
     
-    // Refresh RX/TX indicators more frequently (without redrawing entire status bar)
+    // Check RX/TX activity more often, the LEDs repaint only when they change
     static unsigned long lastRxTxUpdate = 0;
     if (millis() - lastRxTxUpdate > 100) {  // Update 10 times per second
       drawRxTxIndicators(80, 6);
       lastRxTxUpdate = millis();
     }
     
-    // Handle incoming UART data
-    terminalUpdate();
+    // Handle incoming UART data (drains the whole RX buffer in one batch)
+    rxBytes = terminalUpdate();
     
     // Flush SD card buffer periodically
     sdFlush();
@@ -169,6 +188,9 @@ void loop() {
     // Check for REC icon tap (works regardless of keyboard state)
     handleRecIconTouch();
     
+    // Check for grid size tap (switches the cell font)
+    handleFontIconTouch();
+    
     // Then handle keyboard or terminal touches
     if (keyboardVisible) {
       handleKeyboardTouch();
@@ -176,9 +198,25 @@ void loop() {
       // When keyboard is hidden, handle terminal area touch for scrolling
       handleTerminalScrollTouch();
     }
+    
+    // Keep a fling moving, frames follow at once
+    flinging = terminalUpdateFling();
+    
+    // Paint what changed - capped frame rate during bursts, at once when idle
+    terminalRender(rxBytes == 0);
+    
+    // Cursor blink, one cell per phase
+    terminalBlinkCursor();
   }
   
-  delay(10);
+  // Only idle when there was nothing to receive, so sustained traffic
+  // is drained at line rate. In terminal mode the RX task wakes us up
+  // as soon as a burst arrives.
+  if (inSetupMode) {
+    delay(10);
+  } else if (rxBytes == 0 && !flinging) {
+    uartIoWaitForData(10);
+  }
 }
 
 void showStartupScreen() {
@@ -345,7 +383,7 @@ void startTerminal() {
   inSetupMode = false;
   
   // Initialize terminal
-  terminalInit(selectedBaudRate, uartMode);
+  terminalInit(selectedBaudRate, uartMode, cellFont);
   
   setLEDColor(0, 255, 0); // Green - running
   
@@ -355,23 +393,33 @@ void startTerminal() {
   // Show status bar
   drawStatusBar();
   
+#if RENDER_BENCHMARK
+  benchmarkRun();
+#endif
+  
   // Auto-start SD recording if enabled
   if (sdAutoRecord && sdGetStatus() == SD_READY) {
     sdStartRecording();
-    drawStatusBar(); // Update to show red REC icon
+    updateStatusBar(); // Update to show red REC icon
   }
 }
 
 void drawStatusBar() {
-  const int baudRates[] = {9600, 19200, 38400, 57600, 115200, 230400};
-  
+  // Whole bar: the background, then every widget
   tft.fillRect(0, 0, 320, 20, TFT_NAVY);
-  tft.setTextSize(1);
-  tft.setTextColor(TFT_YELLOW, TFT_NAVY);
-  tft.setCursor(5, 6);
-  tft.print(uartMode == 0 ? "USB" : "EXT");
-  tft.print(" ");
-  tft.print(baudRates[selectedBaudRate]);
+  shownBaud = -1;
+  shownRx = -1;
+  shownTx = -1;
+  shownRec = -1;
+  shownGrid = -1;
+  shownKeyboard = -1;
+  shownBattery = -1;
+  updateStatusBar();
+}
+
+void updateStatusBar() {
+  // Port and baud rate (left)
+  drawBaudLabel(5, 6);
   
   // RX/TX indicators (after baud rate)
   drawRxTxIndicators(80, 6);
@@ -379,18 +427,39 @@ void drawStatusBar() {
   // REC icon (between RX/TX and keyboard)
   drawRecIcon(155, 4);
   
+  // Grid size of the cell font (before keyboard)
+  drawFontIcon(193, 6);
+  
   // Keyboard icon (right side)
   drawKeyboardIcon(230, 4);
   
-  // Battery indicator (far right)
+  // Battery indicator and percentage (far right)
   drawBatteryIcon(260, 4);
+}
+
+void drawBaudLabel(int x, int y) {
+  const int baudRates[] = {9600, 19200, 38400, 57600, 115200, 230400};
+  int state = uartMode << 8 | selectedBaudRate;
+  if (state == shownBaud) return;
+  shownBaud = state;
   
-  tft.setCursor(285, 6);
-  tft.print(batteryPercent);
-  tft.print("%");
+  // "USB 115200" at most
+  tft.fillRect(x, y, 60, 8, TFT_NAVY);
+  tft.setTextSize(1);
+  tft.setTextColor(TFT_YELLOW, TFT_NAVY);
+  tft.setCursor(x, y);
+  tft.print(uartMode == 0 ? "USB" : "EXT");
+  tft.print(" ");
+  tft.print(baudRates[selectedBaudRate]);
 }
 
 void drawBatteryIcon(int x, int y) {
+  if (batteryPercent == shownBattery) return;
+  shownBattery = batteryPercent;
+  
+  // Icon and "100%" at most
+  tft.fillRect(x, y, 50, 12, TFT_NAVY);
+  
   // Battery outline
   tft.drawRect(x, y, 18, 10, TFT_WHITE);
   tft.fillRect(x + 18, y + 3, 2, 4, TFT_WHITE); // Battery tip
@@ -410,6 +479,12 @@ void drawBatteryIcon(int x, int y) {
   if (fillWidth > 0) {
     tft.fillRect(x + 1, y + 1, fillWidth, 8, fillColor);
   }
+  
+  tft.setTextSize(1);
+  tft.setTextColor(TFT_WHITE, TFT_NAVY);
+  tft.setCursor(x + 25, y + 2);
+  tft.print(batteryPercent);
+  tft.print("%");
 }
 
 void updateBattery() {
@@ -458,7 +533,10 @@ void updateBattery() {
 }
 
 void drawKeyboardIcon(int x, int y) {
-  // Small keyboard icon
+  if ((int)keyboardVisible == shownKeyboard) return;
+  shownKeyboard = keyboardVisible;
+  
+  // Small keyboard icon, the same pixels in either color
   uint16_t color = keyboardVisible ? TFT_GREEN : TFT_LIGHTGREY;
   
   // Keyboard outline
@@ -478,29 +556,39 @@ void drawRxTxIndicators(int x, int y) {
   bool rxActive = (now - lastRxTime) < activityBlinkDuration;
   bool txActive = (now - lastTxTime) < activityBlinkDuration;
   
-  // RX label
-  tft.setTextSize(1);
-  tft.setTextColor(TFT_WHITE, TFT_NAVY);
-  tft.setCursor(x, y);
-  tft.print("R");
-  
-  // RX LED
-  uint16_t rxColor = rxActive ? TFT_GREEN : TFT_DARKGREY;
-  tft.fillCircle(x + 8, y + 4, 3, rxColor);
+  // Labels only with the whole bar
+  if (shownRx < 0) {
+    tft.setTextSize(1);
+    tft.setTextColor(TFT_WHITE, TFT_NAVY);
+    tft.setCursor(x, y);
+    tft.print("R");
+    tft.setCursor(x + 14, y);
+    tft.print("T");
+  }
   
-  // TX label
-  tft.setCursor(x + 14, y);
-  tft.print("T");
+  // RX LED, a circle covers the one it replaces
+  if ((int)rxActive != shownRx) {
+    shownRx = rxActive;
+    uint16_t rxColor = rxActive ? TFT_GREEN : TFT_DARKGREY;
+    tft.fillCircle(x + 8, y + 4, 3, rxColor);
+  }
   
   // TX LED
-  uint16_t txColor = txActive ? TFT_RED : TFT_DARKGREY;
-  tft.fillCircle(x + 22, y + 4, 3, txColor);
+  if ((int)txActive != shownTx) {
+    shownTx = txActive;
+    uint16_t txColor = txActive ? TFT_RED : TFT_DARKGREY;
+    tft.fillCircle(x + 22, y + 4, 3, txColor);
+  }
 }
 
 void drawRecIcon(int x, int y) {
   // REC icon - only show if SD card present
   SDStatus sdStatus = sdGetStatus();
+  if ((int)sdStatus == shownRec) return;
+  shownRec = sdStatus;
   
+  // Circle and "REC"
+  tft.fillRect(x, y, 32, 12, TFT_NAVY);
   if (sdStatus == SD_NOT_PRESENT) {
     // Don't show icon if no SD card
     return;
@@ -526,6 +614,21 @@ void drawRecIcon(int x, int y) {
   tft.print("REC");
 }
 
+void drawFontIcon(int x, int y) {
+  // Grid size, e.g. "80x36"
+  int state = terminalGetCols() << 8 | terminalGetRows();
+  if (state == shownGrid) return;
+  shownGrid = state;
+  
+  tft.fillRect(x, y, 30, 8, TFT_NAVY);
+  tft.setTextSize(1);
+  tft.setTextColor(TFT_CYAN, TFT_NAVY);
+  tft.setCursor(x, y);
+  tft.print(terminalGetCols());
+  tft.print("x");
+  tft.print(terminalGetRows());
+}
+
 void handleKeyboardIconTouch() {
   static unsigned long lastKeyboardIconTouch = 0;
   static int iconTouchStartY = -1;
@@ -601,8 +704,8 @@ void handleRecIconTouch() {
             sdStartRecording();
           }
           
-          // Redraw status bar to update icon
-          drawStatusBar();
+          // Repaint the REC icon
+          updateStatusBar();
         }
       }
     }
@@ -614,17 +717,64 @@ void handleRecIconTouch() {
   }
 }
 
+void handleFontIconTouch() {
+  static unsigned long lastFontIconTouch = 0;
+  static int fontTouchStartY = -1;
+  static int fontTouchStartX = -1;
+  static int fontLastTouchY = -1;
+  uint16_t touchX, touchY;
+  
+  if (getTouch(&touchX, &touchY)) {
+    // Record initial touch position if just started
+    if (fontLastTouchY == -1) {
+      fontTouchStartY = touchY;
+      fontTouchStartX = touchX;
+      fontLastTouchY = touchY;
+    }
+  } else {
+    // Touch released
+    if (fontLastTouchY != -1) {
+      // Check if this was a tap on the grid size (status bar, no big movement)
+      // Label is at X=193, width=30, so range is 190-225
+      if (fontTouchStartY >= 0 && fontTouchStartY <= 20 &&
+          fontTouchStartX >= 190 && fontTouchStartX <= 225 &&
+          abs(fontLastTouchY - fontTouchStartY) < 5) {
+        // Tapped grid size
+        if (millis() - lastFontIconTouch > 200) {
+          lastFontIconTouch = millis();
+          
+          // Next cell font, kept for the next start
+          cellFont = (cellFont + 1) % CELL_FONT_COUNT;
+          preferences.putInt("font", cellFont);
+          terminalSetFont(cellFont);
+          
+          // Repaint the grid size
+          updateStatusBar();
+        }
+      }
+    }
+    
+    // Reset touch state
+    fontLastTouchY = -1;
+    fontTouchStartY = -1;
+    fontTouchStartX = -1;
+  }
+}
+
 void handleTerminalScrollTouch() {
   static int touchStartY = -1;
   static int touchStartX = -1;
   uint16_t touchX, touchY;
   
   if (getTouch(&touchX, &touchY)) {
-    // Record initial touch position if just started
+    // Record initial touch position if just started, a touch stops a fling
     if (!isDragging && lastTouchY == -1) {
       touchStartY = touchY;
       touchStartX = touchX;
       lastTouchY = touchY;
+      lastDragTime = millis();
+      dragVelocity = 0;
+      terminalStopFling();
     }
     
     // Ignore touches on status bar
@@ -642,19 +792,25 @@ void handleTerminalScrollTouch() {
         isDragging = true;
       }
       
-      // Perform scroll if dragging
-      if (isDragging && abs(delta) >= 3) {  // More sensitive - reduced from 4
-        int linesDelta = delta / 3;  // 3 pixels per line for better responsiveness
-        if (linesDelta != 0) {
-          terminalScroll(linesDelta);
-          lastTouchY = touchY;
+      // Content follows the finger pixel by pixel while dragging
+      if (isDragging && delta != 0) {
+        terminalScrollPixels(delta);
+        
+        // Smoothed finger speed, the fling starts with it on release
+        unsigned long now = millis();
+        if (now > lastDragTime) {
+          float velocity = delta * 1000.0f / (now - lastDragTime);
+          dragVelocity = dragVelocity * 0.6f + velocity * 0.4f;
         }
-      } else {
-        lastTouchY = touchY;
+        lastDragTime = now;
       }
+      lastTouchY = touchY;
     }
   } else {
-    // Touch released - reset state
+    // Touch released - fling if the finger was still moving, then reset state
+    if (isDragging && millis() - lastDragTime < 100) {
+      terminalFling((int)dragVelocity);
+    }
     isDragging = false;
     lastTouchY = -1;
     touchStartY = -1;
@@ -675,8 +831,8 @@ void toggleKeyboard() {
     setLEDColor(0, 255, 0); // Green - normal mode
   }
   
-  // Refresh status bar to update keyboard icon color
-  drawStatusBar();
+  // Repaint the keyboard icon in its new color
+  updateStatusBar();
 }
 
 void setupRGBLED() {
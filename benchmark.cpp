@@ -0,0 +1,129 @@
+/*
+ * benchmark.cpp - Display throughput benchmarks
+ *
+ * Results are written to the terminal screen with local echo, so they
+ * don't end up on the UART (which is the USB link in USB mode).
+ */
+
+#include "benchmark.h"
+#include "display.h"
+#include "renderer.h"
+#include "terminal.h"
+#include "utf8.h"
+
+// Push full text rows as fast as possible: achieved rows/s and the share
+// of time the CPU was blocked waiting for SPI
+static void benchmarkRowPush(char* result, size_t size) {
+  int cols = terminalGetCols();
+  int gridRows = terminalGetRows();
+  int cellHeight = cellFontHeight(terminalGetFont());
+  TermCell cells[TERMINAL_MAX_COLS];
+  for (int x = 0; x < cols; x++) {
+    cells[x].glyph = '!' + (x % 94);
+    cells[x].colors = CELL_DEFAULT_COLORS;
+  }
+  
+  RendererStats before;
+  RendererStats after;
+  rendererGetStats(&before);
+  
+  rendererBeginFrame();
+  for (int i = 0; i < BENCHMARK_ROWS; i++) {
+    int y = TERMINAL_START_Y + (i % gridRows) * cellHeight;
+    rendererDrawCells(cells, cols, 0, y);
+  }
+  rendererEndFrame();
+  
+  rendererGetStats(&after);
+#if RENDER_FRAMEBUFFER
+  // Rows only reach the framebuffer; the glass gets the dirty tiles
+  uint32_t pushed = after.tiles - before.tiles;
+  const char* unit = "tiles";
+#else
+  uint32_t pushed = after.rows - before.rows;
+  const char* unit = "rows";
+#endif
+  uint32_t elapsedUs = after.frameUs - before.frameUs;
+  uint32_t blockedUs = after.blockedUs - before.blockedUs;
+  uint32_t hits = after.glyphHits - before.glyphHits;
+  uint32_t lookups = hits + after.glyphMisses - before.glyphMisses;
+  if (elapsedUs == 0) elapsedUs = 1;
+  if (lookups == 0) lookups = 1;
+  
+  snprintf(result, size, "Row push: %u %s/s, %u%% blocked on SPI (%s), %u%% glyph cache hits\r\n",
+           (unsigned)((uint64_t)pushed * 1000000 / elapsedUs),
+           unit,
+           (unsigned)((uint64_t)blockedUs * 100 / elapsedUs),
+           rendererUsesDMA() ? "DMA" : "no DMA",
+           (unsigned)((uint64_t)hits * 100 / lookups));
+}
+
+// Draw one colored log line and count the work per call: color lookups
+// (one per run of cells sharing colors), glyph tile lookups, blank cells
+// filled without a tile and row windows pushed
+static void benchmarkLogLine(char* result, size_t size) {
+  static const struct {
+    const char* text;
+    uint16_t attributes;
+    uint8_t colors;
+  } parts[] = {
+    { "12:04:33 ", 0, 8 << 4 | CELL_DEFAULT_BG },
+    { "[WARN]", CELL_BOLD, 3 << 4 | CELL_DEFAULT_BG },
+    { " wifi: ", 0, 6 << 4 | CELL_DEFAULT_BG },
+    { "rssi ", 0, CELL_DEFAULT_COLORS },
+    { "-78", 0, 1 << 4 | CELL_DEFAULT_BG },
+    { " dBm, retrying", 0, CELL_DEFAULT_COLORS },
+  };
+  int cols = terminalGetCols();
+  TermCell cells[TERMINAL_MAX_COLS];
+  int count = 0;
+  for (size_t p = 0; p < sizeof(parts) / sizeof(parts[0]); p++) {
+    for (const char* c = parts[p].text; *c != '\0' && count < cols; c++) {
+      cells[count].glyph = *c | parts[p].attributes;
+      cells[count].colors = parts[p].colors;
+      count++;
+    }
+  }
+  for (; count < cols; count++) {
+    cells[count].glyph = ' ';
+    cells[count].colors = CELL_DEFAULT_COLORS;
+  }
+  
+  RendererStats before;
+  RendererStats after;
+  rendererGetStats(&before);
+  rendererBeginFrame();
+  rendererDrawCells(cells, cols, 0, TERMINAL_START_Y);
+  rendererEndFrame();
+  rendererGetStats(&after);
+  
+#if RENDER_FRAMEBUFFER
+  uint32_t pushed = after.tiles - before.tiles;
+  const char* unit = "tiles pushed";
+#else
+  uint32_t pushed = after.rows - before.rows;
+  const char* unit = "push";
+#endif
+  snprintf(result, size, "Log line: %d cells, %u color lookups, %u tile lookups, %u blanks filled, %u %s\r\n",
+           cols,
+           (unsigned)(after.runs - before.runs),
+           (unsigned)(after.glyphHits + after.glyphMisses - before.glyphHits - before.glyphMisses),
+           (unsigned)(after.blankCells - before.blankCells),
+           (unsigned)pushed,
+           unit);
+}
+
+void benchmarkRun() {
+  char result[112];
+  char logLine[112];
+  benchmarkRowPush(result, sizeof(result));
+  benchmarkLogLine(logLine, sizeof(logLine));
+  
+  // Benchmark scribbled over the text area
+  rendererFillRect(0, TERMINAL_START_Y, SCREEN_WIDTH, SCREEN_HEIGHT - TERMINAL_START_Y, TFT_BLACK);
+  terminalInvalidate();
+  terminalRedraw();
+  
+  terminalLocalEchoText(result);
+  terminalLocalEchoText(logLine);
+}
@@ -0,0 +1,14 @@
+/*
+ * benchmark.h - Display throughput benchmarks
+ */
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// Run the benchmarks and print the results into the terminal (local echo only)
+void benchmarkRun();
+
+#endif
@@ -38,11 +38,60 @@
 #define UART_TX 1
 
 // Terminal settings
-#define TERMINAL_COLS 53  // Characters per line (6px font)
-#define TERMINAL_ROWS 27  // Lines visible on screen (8px font)
-#define TERMINAL_BUFFER_ROWS 100  // Total buffer lines
+#define TERMINAL_FONT 0  // Cell font until one is saved: 0 = 6x8 (53x27 grid), 1 = 4x6 (80x36 grid)
+#define TERMINAL_MAX_COLS 80  // Widest grid of the cell fonts, sizes the screen buffer
+#define TERMINAL_MAX_ROWS 36  // Tallest grid of the cell fonts
 #define TERMINAL_START_Y 22  // Start below status bar
 #define TERMINAL_BUFFER_SIZE 2048
+#define CURSOR_SHAPE 3        // Cursor until DECSCUSR sets one: 1/2 block, 3/4 underline, 5/6 bar (odd blinks)
+#define CURSOR_BLINK_MS 500   // Blink phase length
+
+// Scrollback settings (lines that scrolled off the screen, stored compressed)
+#define SCROLLBACK_ARENA_SIZE 16384  // Bytes for line text and attributes (max 65536)
+#define SCROLLBACK_MAX_LINES 2048    // Max lines held, 2 bytes each for the offset ring
+#define SCROLLBACK_SPILL 1           // Page evicted lines out to an SD spill file (if a card is mounted)
+#define SCROLLBACK_SPILL_FILE "/scrollback.bin"
+#define SCROLLBACK_PAGE_SIZE 2048    // Spill page size
+#define SCROLLBACK_SPILL_PAGES 1024  // Pages in the spill file ring (2 MB), 4 bytes of RAM index each
+#define SCROLLBACK_CACHE_PAGES 4     // Spilled pages cached in RAM (current page + read-ahead)
+#define SPILL_TASK_CORE 0
+#define SPILL_TASK_PRIORITY 2        // Below the UART RX task
+#define SPILL_TASK_STACK_SIZE 4096
+#define REFLOW_CACHE_LINES 128       // Logical lines whose rows are cached per cell font (8 bytes each)
+
+// Scrollback search settings
+#define SEARCH_MAX_QUERY 32        // Max characters in a search query
+#define SEARCH_LINES_PER_STEP 256  // Lines checked per frame while searching
+
+// Renderer settings
+#define RENDER_FPS_MAX 40  // Max screen repaints per second while data is arriving
+#define RENDER_USE_DMA 1   // Push text rows with SPI DMA (ESP32)
+#define RENDER_FRAMEBUFFER 0 // Keep the text area in a 4bpp framebuffer (35 KB), push dirty 8x8 tiles
+#define RENDER_BENCHMARK 0 // Run display benchmarks when the terminal starts
+#define BENCHMARK_ROWS 540 // Rows pushed by the row push benchmark (20 screens)
+#define GLYPH_CACHE_ENTRIES 64  // Cached glyph tiles of the current cell font (104 bytes each)
+#define GLYPH_CACHE_WAYS 4      // Tiles per cache set (LRU inside a set)
+
+// Touch scrolling settings
+#define SCROLL_FLING_DECEL 1500         // Fling deceleration (pixels/s^2)
+#define SCROLL_FLING_MIN_VELOCITY 40    // Slower flings stop (pixels/s)
+#define SCROLL_FLING_MAX_VELOCITY 3000  // Fling speed limit (pixels/s)
+
+// UART RX settings
+#define UART_RX_BUFFER_SIZE 4096  // Driver RX buffer, holds data while the screen repaints
+#define RX_CHUNK_SIZE 256         // Bytes read from the driver per read() call
+#define RX_BATCH_MAX_BYTES 2048   // Max bytes parsed per terminalUpdate() call
+#define RX_BATCH_MAX_US 20000     // Max time spent parsing per terminalUpdate() call
+#define RX_RING_SIZE 16384        // RX task -> parser ring buffer (power of two)
+#define RX_TASK_CORE 0            // loop() runs on core 1
+#define RX_TASK_PRIORITY 5
+#define RX_TASK_STACK_SIZE 3072
+
+// ESP-IDF uart driver backend (1 = event-driven IDF driver, 0 = HardwareSerial receive callback)
+#define UART_IDF_DRIVER 0
+#define UART_EVENT_QUEUE_LEN 20
+#define UART_RX_FIFO_FULL_THRESHOLD 100  // Interrupt when hardware FIFO (128 bytes) holds this many
+#define UART_RX_TIMEOUT_SYMBOLS 4        // Interrupt after this many idle symbol times
 
 // Keyboard settings
 #define KEYBOARD_Y_POS 80   // Keyboard starts at Y=80
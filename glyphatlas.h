@@ -0,0 +1,1021 @@
+/*
+ * glyphatlas.h - Terminal glyph atlas
+ *
+ * Generated by tools/glyphgen.py, do not edit.
+ * Included by utf8.cpp only.
+ */
+
+#ifndef GLYPHATLAS_H
+#define GLYPHATLAS_H
+
+#include <Arduino.h>
+
+#define GLYPH_ATLAS_COUNT 482
+#define GLYPH_RANGE_COUNT 8
+#define GLYPH_FONT_COUNT 2
+
+// Codepoints first..first+count-1 have font indices index..index+count-1
+struct GlyphRange {
+  uint32_t first;
+  uint16_t count;
+  uint16_t index;
+};
+
+// Sorted by codepoint (and font index), padded with entries no
+// codepoint or index reaches
+static const GlyphRange glyphRanges[GLYPH_RANGE_COUNT] = {
+  {0x0000, 128, 0},
+  {0x00A0, 96, 128},
+  {0x0400, 96, 224},
+  {0x0490, 2, 320},
+  {0x2500, 160, 322},
+  {0xFFFFFFFF, 0, 0xFFFF},
+  {0xFFFFFFFF, 0, 0xFFFF},
+  {0xFFFFFFFF, 0, 0xFFFF},
+};
+
+// 6x8 cells: 6 column bytes per font index, LSB at top
+static const uint8_t glyphAtlas6x8[GLYPH_ATLAS_COUNT][6] PROGMEM = {
+  {0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  // U+0000
+  {0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  // U+0001
+  {0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  // U+0002
+  {0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  // U+0003
+  {0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  // U+0004
+  {0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  // U+0005
+  {0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  // U+0006
+  {0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  // U+0007
+  {0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  // U+0008
+  {0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  // U+0009
+  {0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  // U+000A
+  {0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  // U+000B
+  {0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  // U+000C
+  {0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  // U+000D
+  {0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  // U+000E
+  {0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  // U+000F
+  {0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  // U+0010
+  {0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  // U+0011
+  {0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  // U+0012
+  {0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  // U+0013
+  {0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  // U+0014
+  {0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  // U+0015
+  {0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  // U+0016
+  {0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  // U+0017
+  {0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  // U+0018
+  {0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  // U+0019
+  {0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  // U+001A
+  {0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  // U+001B
+  {0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  // U+001C
+  {0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  // U+001D
+  {0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  // U+001E
+  {0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  // U+001F
+  {0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  // U+0020
+  {0x00, 0x00, 0x5F, 0x00, 0x00, 0x00},  // U+0021 !
+  {0x00, 0x07, 0x00, 0x07, 0x00, 0x00},  // U+0022 "
+  {0x14, 0x7F, 0x14, 0x7F, 0x14, 0x00},  // U+0023 #
+  {0x24, 0x2A, 0x7F, 0x2A, 0x12, 0x00},  // U+0024 $
+  {0x23, 0x13, 0x08, 0x64, 0x62, 0x00},  // U+0025 %
+  {0x36, 0x49, 0x56, 0x20, 0x50, 0x00},  // U+0026 &
+  {0x00, 0x08, 0x07, 0x03, 0x00, 0x00},  // U+0027 '
+  {0x00, 0x1C, 0x22, 0x41, 0x00, 0x00},  // U+0028 (
+  {0x00, 0x41, 0x22, 0x1C, 0x00, 0x00},  // U+0029 )
+  {0x2A, 0x1C, 0x7F, 0x1C, 0x2A, 0x00},  // U+002A *
+  {0x08, 0x08, 0x3E, 0x08, 0x08, 0x00},  // U+002B +
+  {0x00, 0x80, 0x70, 0x30, 0x00, 0x00},  // U+002C ,
+  {0x08, 0x08, 0x08, 0x08, 0x08, 0x00},  // U+002D -
+  {0x00, 0x00, 0x60, 0x60, 0x00, 0x00},  // U+002E .
+  {0x20, 0x10, 0x08, 0x04, 0x02, 0x00},  // U+002F /
+  {0x3E, 0x51, 0x49, 0x45, 0x3E, 0x00},  // U+0030 0
+  {0x00, 0x42, 0x7F, 0x40, 0x00, 0x00},  // U+0031 1
+  {0x72, 0x49, 0x49, 0x49, 0x46, 0x00},  // U+0032 2
+  {0x21, 0x41, 0x49, 0x4D, 0x33, 0x00},  // U+0033 3
+  {0x18, 0x14, 0x12, 0x7F, 0x10, 0x00},  // U+0034 4
+  {0x27, 0x45, 0x45, 0x45, 0x39, 0x00},  // U+0035 5
+  {0x3C, 0x4A, 0x49, 0x49, 0x31, 0x00},  // U+0036 6
+  {0x41, 0x21, 0x11, 0x09, 0x07, 0x00},  // U+0037 7
+  {0x36, 0x49, 0x49, 0x49, 0x36, 0x00},  // U+0038 8
+  {0x46, 0x49, 0x49, 0x29, 0x1E, 0x00},  // U+0039 9
+  {0x00, 0x00, 0x14, 0x00, 0x00, 0x00},  // U+003A :
+  {0x00, 0x40, 0x34, 0x00, 0x00, 0x00},  // U+003B ;
+  {0x00, 0x08, 0x14, 0x22, 0x41, 0x00},  // U+003C <
+  {0x14, 0x14, 0x14, 0x14, 0x14, 0x00},  // U+003D =
+  {0x00, 0x41, 0x22, 0x14, 0x08, 0x00},  // U+003E >
+  {0x02, 0x01, 0x59, 0x09, 0x06, 0x00},  // U+003F ?
+  {0x3E, 0x41, 0x5D, 0x59, 0x4E, 0x00},  // U+0040 @
+  {0x7C, 0x12, 0x11, 0x12, 0x7C, 0x00},  // U+0041 A
+  {0x7F, 0x49, 0x49, 0x49, 0x36, 0x00},  // U+0042 B
+  {0x3E, 0x41, 0x41, 0x41, 0x22, 0x00},  // U+0043 C
+  {0x7F, 0x41, 0x41, 0x41, 0x3E, 0x00},  // U+0044 D
+  {0x7F, 0x49, 0x49, 0x49, 0x41, 0x00},  // U+0045 E
+  {0x7F, 0x09, 0x09, 0x09, 0x01, 0x00},  // U+0046 F
+  {0x3E, 0x41, 0x41, 0x51, 0x73, 0x00},  // U+0047 G
+  {0x7F, 0x08, 0x08, 0x08, 0x7F, 0x00},  // U+0048 H
+  {0x00, 0x41, 0x7F, 0x41, 0x00, 0x00},  // U+0049 I
+  {0x20, 0x40, 0x41, 0x3F, 0x01, 0x00},  // U+004A J
+  {0x7F, 0x08, 0x14, 0x22, 0x41, 0x00},  // U+004B K
+  {0x7F, 0x40, 0x40, 0x40, 0x40, 0x00},  // U+004C L
+  {0x7F, 0x02, 0x1C, 0x02, 0x7F, 0x00},  // U+004D M
+  {0x7F, 0x04, 0x08, 0x10, 0x7F, 0x00},  // U+004E N
+  {0x3E, 0x41, 0x41, 0x41, 0x3E, 0x00},  // U+004F O
+  {0x7F, 0x09, 0x09, 0x09, 0x06, 0x00},  // U+0050 P
+  {0x3E, 0x41, 0x51, 0x21, 0x5E, 0x00},  // U+0051 Q
+  {0x7F, 0x09, 0x19, 0x29, 0x46, 0x00},  // U+0052 R
+  {0x26, 0x49, 0x49, 0x49, 0x32, 0x00},  // U+0053 S
+  {0x03, 0x01, 0x7F, 0x01, 0x03, 0x00},  // U+0054 T
+  {0x3F, 0x40, 0x40, 0x40, 0x3F, 0x00},  // U+0055 U
+  {0x1F, 0x20, 0x40, 0x20, 0x1F, 0x00},  // U+0056 V
+  {0x3F, 0x40, 0x38, 0x40, 0x3F, 0x00},  // U+0057 W
+  {0x63, 0x14, 0x08, 0x14, 0x63, 0x00},  // U+0058 X
+  {0x03, 0x04, 0x78, 0x04, 0x03, 0x00},  // U+0059 Y
+  {0x61, 0x59, 0x49, 0x4D, 0x43, 0x00},  // U+005A Z
+  {0x00, 0x7F, 0x41, 0x41, 0x41, 0x00},  // U+005B [
+  {0x02, 0x04, 0x08, 0x10, 0x20, 0x00},  // U+005C backslash
+  {0x00, 0x41, 0x41, 0x41, 0x7F, 0x00},  // U+005D ]
+  {0x04, 0x02, 0x01, 0x02, 0x04, 0x00},  // U+005E ^
+  {0x40, 0x40, 0x40, 0x40, 0x40, 0x00},  // U+005F _
+  {0x00, 0x03, 0x07, 0x08, 0x00, 0x00},  // U+0060 `
+  {0x20, 0x54, 0x54, 0x78, 0x40, 0x00},  // U+0061 a
+  {0x7F, 0x28, 0x44, 0x44, 0x38, 0x00},  // U+0062 b
+  {0x38, 0x44, 0x44, 0x44, 0x28, 0x00},  // U+0063 c
+  {0x38, 0x44, 0x44, 0x28, 0x7F, 0x00},  // U+0064 d
+  {0x38, 0x54, 0x54, 0x54, 0x18, 0x00},  // U+0065 e
+  {0x00, 0x08, 0x7E, 0x09, 0x02, 0x00},  // U+0066 f
+  {0x18, 0xA4, 0xA4, 0x9C, 0x78, 0x00},  // U+0067 g
+  {0x7F, 0x08, 0x04, 0x04, 0x78, 0x00},  // U+0068 h
+  {0x00, 0x44, 0x7D, 0x40, 0x00, 0x00},  // U+0069 i
+  {0x20, 0x40, 0x40, 0x3D, 0x00, 0x00},  // U+006A j
+  {0x7F, 0x10, 0x28, 0x44, 0x00, 0x00},  // U+006B k
+  {0x00, 0x41, 0x7F, 0x40, 0x00, 0x00},  // U+006C l
+  {0x7C, 0x04, 0x78, 0x04, 0x78, 0x00},  // U+006D m
+  {0x7C, 0x08, 0x04, 0x04, 0x78, 0x00},  // U+006E n
+  {0x38, 0x44, 0x44, 0x44, 0x38, 0x00},  // U+006F o
+  {0xFC, 0x18, 0x24, 0x24, 0x18, 0x00},  // U+0070 p
+  {0x18, 0x24, 0x24, 0x18, 0xFC, 0x00},  // U+0071 q
+  {0x7C, 0x08, 0x04, 0x04, 0x08, 0x00},  // U+0072 r
+  {0x48, 0x54, 0x54, 0x54, 0x24, 0x00},  // U+0073 s
+  {0x04, 0x04, 0x3F, 0x44, 0x24, 0x00},  // U+0074 t
+  {0x3C, 0x40, 0x40, 0x20, 0x7C, 0x00},  // U+0075 u
+  {0x1C, 0x20, 0x40, 0x20, 0x1C, 0x00},  // U+0076 v
+  {0x3C, 0x40, 0x30, 0x40, 0x3C, 0x00},  // U+0077 w
+  {0x44, 0x28, 0x10, 0x28, 0x44, 0x00},  // U+0078 x
+  {0x4C, 0x90, 0x90, 0x90, 0x7C, 0x00},  // U+0079 y
+  {0x44, 0x64, 0x54, 0x4C, 0x44, 0x00},  // U+007A z
+  {0x00, 0x08, 0x36, 0x41, 0x00, 0x00},  // U+007B {
+  {0x00, 0x00, 0x77, 0x00, 0x00, 0x00},  // U+007C |
+  {0x00, 0x41, 0x36, 0x08, 0x00, 0x00},  // U+007D }
+  {0x02, 0x01, 0x02, 0x04, 0x02, 0x00},  // U+007E ~
+  {0x3C, 0x26, 0x23, 0x26, 0x3C, 0x00},  // U+007F
+  {0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  // U+00A0
+  {0x00, 0x00, 0x7D, 0x00, 0x00, 0x00},  // U+00A1 ¡
+  {0x18, 0x24, 0x7E, 0x24, 0x24, 0x00},  // U+00A2 ¢
+  {0x48, 0x3E, 0x49, 0x41, 0x22, 0x00},  // U+00A3 £
+  {0x22, 0x1C, 0x14, 0x1C, 0x22, 0x00},  // U+00A4 ¤
+  {0x15, 0x16, 0x7C, 0x16, 0x15, 0x00},  // U+00A5 ¥
+  {0x00, 0x00, 0x77, 0x00, 0x00, 0x00},  // U+00A6 ¦
+  {0x4A, 0x55, 0x55, 0x29, 0x00, 0x00},  // U+00A7 §
+  {0x00, 0x01, 0x00, 0x01, 0x00, 0x00},  // U+00A8 ¨
+  {0x3E, 0x41, 0x5D, 0x55, 0x3E, 0x00},  // U+00A9 ©
+  {0x48, 0x55, 0x55, 0x5E, 0x00, 0x00},  // U+00AA ª
+  {0x08, 0x14, 0x2A, 0x14, 0x22, 0x00},  // U+00AB «
+  {0x08, 0x08, 0x08, 0x08, 0x38, 0x00},  // U+00AC ¬
+  {0x08, 0x08, 0x08, 0x08, 0x08, 0x00},  // U+00AD
+  {0x3E, 0x41, 0x5D, 0x49, 0x36, 0x00},  // U+00AE ®
+  {0x01, 0x01, 0x01, 0x01, 0x01, 0x00},  // U+00AF ¯
+  {0x00, 0x02, 0x05, 0x02, 0x00, 0x00},  // U+00B0 °
+  {0x44, 0x44, 0x5F, 0x44, 0x44, 0x00},  // U+00B1 ±
+  {0x00, 0x09, 0x0D, 0x0A, 0x00, 0x00},  // U+00B2 ²
+  {0x00, 0x09, 0x0B, 0x0F, 0x00, 0x00},  // U+00B3 ³
+  {0x00, 0x00, 0x02, 0x01, 0x00, 0x00},  // U+00B4 ´
+  {0xFC, 0x40, 0x40, 0x3C, 0x40, 0x00},  // U+00B5 µ
+  {0x06, 0x0F, 0x7F, 0x01, 0x7F, 0x00},  // U+00B6 ¶
+  {0x00, 0x00, 0x08, 0x00, 0x00, 0x00},  // U+00B7 ·
+  {0x00, 0x80, 0xC0, 0x00, 0x00, 0x00},  // U+00B8 ¸
+  {0x00, 0x0A, 0x0F, 0x08, 0x00, 0x00},  // U+00B9 ¹
+  {0x12, 0x15, 0x15, 0x12, 0x00, 0x00},  // U+00BA º
+  {0x22, 0x14, 0x2A, 0x14, 0x08, 0x00},  // U+00BB »
+  {0x17, 0x08, 0x34, 0x7A, 0x21, 0x00},  // U+00BC ¼
+  {0x17, 0x08, 0x44, 0x6A, 0x59, 0x00},  // U+00BD ½
+  {0x15, 0x0F, 0x32, 0x7C, 0x21, 0x00},  // U+00BE ¾
+  {0x30, 0x48, 0x45, 0x40, 0x20, 0x00},  // U+00BF ¿
+  {0x78, 0x15, 0x16, 0x14, 0x78, 0x00},  // U+00C0 À
+  {0x78, 0x14, 0x16, 0x15, 0x78, 0x00},  // U+00C1 Á
+  {0x78, 0x16, 0x15, 0x16, 0x78, 0x00},  // U+00C2 Â
+  {0x7A, 0x15, 0x15, 0x16, 0x79, 0x00},  // U+00C3 Ã
+  {0x78, 0x15, 0x14, 0x15, 0x78, 0x00},  // U+00C4 Ä
+  {0x78, 0x17, 0x15, 0x17, 0x78, 0x00},  // U+00C5 Å
+  {0x7E, 0x09, 0x7F, 0x49, 0x49, 0x00},  // U+00C6 Æ
+  {0x3E, 0xC1, 0xC1, 0x41, 0x22, 0x00},  // U+00C7 Ç
+  {0x7C, 0x55, 0x56, 0x54, 0x44, 0x00},  // U+00C8 È
+  {0x7C, 0x54, 0x56, 0x55, 0x44, 0x00},  // U+00C9 É
+  {0x7C, 0x56, 0x55, 0x56, 0x44, 0x00},  // U+00CA Ê
+  {0x7C, 0x55, 0x54, 0x55, 0x44, 0x00},  // U+00CB Ë
+  {0x00, 0x45, 0x7E, 0x44, 0x00, 0x00},  // U+00CC Ì
+  {0x00, 0x44, 0x7E, 0x45, 0x00, 0x00},  // U+00CD Í
+  {0x00, 0x46, 0x7D, 0x46, 0x00, 0x00},  // U+00CE Î
+  {0x00, 0x45, 0x7C, 0x45, 0x00, 0x00},  // U+00CF Ï
+  {0x49, 0x7F, 0x49, 0x41, 0x3E, 0x00},  // U+00D0 Ð
+  {0x7E, 0x09, 0x11, 0x22, 0x7D, 0x00},  // U+00D1 Ñ
+  {0x38, 0x45, 0x46, 0x44, 0x38, 0x00},  // U+00D2 Ò
+  {0x38, 0x44, 0x46, 0x45, 0x38, 0x00},  // U+00D3 Ó
+  {0x38, 0x46, 0x45, 0x46, 0x38, 0x00},  // U+00D4 Ô
+  {0x3A, 0x45, 0x45, 0x46, 0x39, 0x00},  // U+00D5 Õ
+  {0x38, 0x45, 0x44, 0x45, 0x38, 0x00},  // U+00D6 Ö
+  {0x22, 0x14, 0x08, 0x14, 0x22, 0x00},  // U+00D7 ×
+  {0x3E, 0x61, 0x5D, 0x43, 0x3E, 0x00},  // U+00D8 Ø
+  {0x3C, 0x41, 0x42, 0x40, 0x3C, 0x00},  // U+00D9 Ù
+  {0x3C, 0x40, 0x42, 0x41, 0x3C, 0x00},  // U+00DA Ú
+  {0x3C, 0x42, 0x41, 0x42, 0x3C, 0x00},  // U+00DB Û
+  {0x3C, 0x41, 0x40, 0x41, 0x3C, 0x00},  // U+00DC Ü
+  {0x04, 0x08, 0x72, 0x09, 0x04, 0x00},  // U+00DD Ý
+  {0x7F, 0x12, 0x12, 0x12, 0x0C, 0x00},  // U+00DE Þ
+  {0x7E, 0x01, 0x45, 0x4A, 0x30, 0x00},  // U+00DF ß
+  {0x20, 0x55, 0x56, 0x78, 0x40, 0x00},  // U+00E0 à
+  {0x20, 0x54, 0x56, 0x79, 0x40, 0x00},  // U+00E1 á
+  {0x20, 0x56, 0x55, 0x7A, 0x40, 0x00},  // U+00E2 â
+  {0x22, 0x55, 0x55, 0x7A, 0x41, 0x00},  // U+00E3 ã
+  {0x20, 0x55, 0x54, 0x79, 0x40, 0x00},  // U+00E4 ä
+  {0x20, 0x57, 0x55, 0x7B, 0x40, 0x00},  // U+00E5 å
+  {0x24, 0x54, 0x38, 0x54, 0x58, 0x00},  // U+00E6 æ
+  {0x38, 0xC4, 0xC4, 0x44, 0x28, 0x00},  // U+00E7 ç
+  {0x38, 0x55, 0x56, 0x54, 0x18, 0x00},  // U+00E8 è
+  {0x38, 0x54, 0x56, 0x55, 0x18, 0x00},  // U+00E9 é
+  {0x38, 0x56, 0x55, 0x56, 0x18, 0x00},  // U+00EA ê
+  {0x38, 0x55, 0x54, 0x55, 0x18, 0x00},  // U+00EB ë
+  {0x00, 0x45, 0x7E, 0x40, 0x00, 0x00},  // U+00EC ì
+  {0x00, 0x44, 0x7E, 0x41, 0x00, 0x00},  // U+00ED í
+  {0x00, 0x46, 0x7D, 0x42, 0x00, 0x00},  // U+00EE î
+  {0x00, 0x45, 0x7C, 0x41, 0x00, 0x00},  // U+00EF ï
+  {0x20, 0x55, 0x52, 0x55, 0x38, 0x00},  // U+00F0 ð
+  {0x7E, 0x09, 0x05, 0x06, 0x79, 0x00},  // U+00F1 ñ
+  {0x38, 0x45, 0x46, 0x44, 0x38, 0x00},  // U+00F2 ò
+  {0x38, 0x44, 0x46, 0x45, 0x38, 0x00},  // U+00F3 ó
+  {0x38, 0x46, 0x45, 0x46, 0x38, 0x00},  // U+00F4 ô
+  {0x3A, 0x45, 0x45, 0x46, 0x39, 0x00},  // U+00F5 õ
+  {0x38, 0x45, 0x44, 0x45, 0x38, 0x00},  // U+00F6 ö
+  {0x08, 0x08, 0x2A, 0x08, 0x08, 0x00},  // U+00F7 ÷
+  {0x38, 0x64, 0x54, 0x4C, 0x38, 0x00},  // U+00F8 ø
+  {0x3C, 0x41, 0x42, 0x20, 0x7C, 0x00},  // U+00F9 ù
+  {0x3C, 0x40, 0x42, 0x21, 0x7C, 0x00},  // U+00FA ú
+  {0x3C, 0x42, 0x41, 0x22, 0x7C, 0x00},  // U+00FB û
+  {0x3C, 0x41, 0x40, 0x21, 0x7C, 0x00},  // U+00FC ü
+  {0x4C, 0x90, 0x92, 0x91, 0x7C, 0x00},  // U+00FD ý
+  {0xFF, 0x24, 0x24, 0x24, 0x18, 0x00},  // U+00FE þ
+  {0x4C, 0x91, 0x90, 0x91, 0x7C, 0x00},  // U+00FF ÿ
+  {0x7C, 0x55, 0x56, 0x54, 0x44, 0x00},  // U+0400 Ѐ
+  {0x7C, 0x55, 0x54, 0x55, 0x44, 0x00},  // U+0401 Ё
+  {0x01, 0x7F, 0x05, 0x45, 0x38, 0x00},  // U+0402 Ђ
+  {0x7C, 0x04, 0x06, 0x05, 0x04, 0x00},  // U+0403 Ѓ
+  {0x3E, 0x49, 0x49, 0x49, 0x22, 0x00},  // U+0404 Є
+  {0x26, 0x49, 0x49, 0x49, 0x32, 0x00},  // U+0405 Ѕ
+  {0x00, 0x41, 0x7F, 0x41, 0x00, 0x00},  // U+0406 І
+  {0x00, 0x45, 0x7C, 0x45, 0x00, 0x00},  // U+0407 Ї
+  {0x20, 0x40, 0x41, 0x3F, 0x01, 0x00},  // U+0408 Ј
+  {0x40, 0x3F, 0x01, 0x7F, 0x48, 0x30},  // U+0409 Љ
+  {0x7F, 0x08, 0x08, 0x7F, 0x48, 0x30},  // U+040A Њ
+  {0x01, 0x7F, 0x05, 0x05, 0x78, 0x00},  // U+040B Ћ
+  {0x7C, 0x10, 0x2A, 0x45, 0x00, 0x00},  // U+040C Ќ
+  {0x7C, 0x21, 0x12, 0x08, 0x7C, 0x00},  // U+040D Ѝ
+  {0x0C, 0x51, 0x52, 0x51, 0x3C, 0x00},  // U+040E Ў
+  {0x7F, 0x40, 0xC0, 0x40, 0x7F, 0x00},  // U+040F Џ
+  {0x7C, 0x12, 0x11, 0x12, 0x7C, 0x00},  // U+0410 А
+  {0x7F, 0x49, 0x49, 0x49, 0x30, 0x00},  // U+0411 Б
+  {0x7F, 0x49, 0x49, 0x49, 0x36, 0x00},  // U+0412 В
+  {0x7F, 0x01, 0x01, 0x01, 0x01, 0x00},  // U+0413 Г
+  {0xC0, 0x7E, 0x41, 0x7F, 0xC0, 0x00},  // U+0414 Д
+  {0x7F, 0x49, 0x49, 0x49, 0x41, 0x00},  // U+0415 Е
+  {0x63, 0x14, 0x7F, 0x14, 0x63, 0x00},  // U+0416 Ж
+  {0x22, 0x41, 0x49, 0x49, 0x36, 0x00},  // U+0417 З
+  {0x7F, 0x20, 0x10, 0x08, 0x7F, 0x00},  // U+0418 И
+  {0x7F, 0x20, 0x13, 0x08, 0x7F, 0x00},  // U+0419 Й
+  {0x7F, 0x08, 0x14, 0x22, 0x41, 0x00},  // U+041A К
+  {0x78, 0x04, 0x02, 0x01, 0x7F, 0x00},  // U+041B Л
+  {0x7F, 0x02, 0x0C, 0x02, 0x7F, 0x00},  // U+041C М
+  {0x7F, 0x08, 0x08, 0x08, 0x7F, 0x00},  // U+041D Н
+  {0x3E, 0x41, 0x41, 0x41, 0x3E, 0x00},  // U+041E О
+  {0x7F, 0x01, 0x01, 0x01, 0x7F, 0x00},  // U+041F П
+  {0x7F, 0x09, 0x09, 0x09, 0x06, 0x00},  // U+0420 Р
+  {0x3E, 0x41, 0x41, 0x41, 0x22, 0x00},  // U+0421 С
+  {0x01, 0x01, 0x7F, 0x01, 0x01, 0x00},  // U+0422 Т
+  {0x07, 0x48, 0x48, 0x48, 0x3F, 0x00},  // U+0423 У
+  {0x0E, 0x11, 0x7F, 0x11, 0x0E, 0x00},  // U+0424 Ф
+  {0x63, 0x14, 0x08, 0x14, 0x63, 0x00},  // U+0425 Х
+  {0x7F, 0x40, 0x40, 0x7F, 0xC0, 0x00},  // U+0426 Ц
+  {0x07, 0x08, 0x08, 0x08, 0x7F, 0x00},  // U+0427 Ч
+  {0x7F, 0x40, 0x7F, 0x40, 0x7F, 0x00},  // U+0428 Ш
+  {0x7F, 0x40, 0x7F, 0x40, 0xFF, 0x00},  // U+0429 Щ
+  {0x01, 0x7F, 0x48, 0x48, 0x30, 0x00},  // U+042A Ъ
+  {0x7F, 0x48, 0x30, 0x00, 0x7F, 0x00},  // U+042B Ы
+  {0x7F, 0x48, 0x48, 0x48, 0x30, 0x00},  // U+042C Ь
+  {0x22, 0x41, 0x49, 0x49, 0x3E, 0x00},  // U+042D Э
+  {0x7F, 0x08, 0x3E, 0x41, 0x3E, 0x00},  // U+042E Ю
+  {0x46, 0x29, 0x19, 0x09, 0x7F, 0x00},  // U+042F Я
+  {0x20, 0x54, 0x54, 0x54, 0x78, 0x00},  // U+0430 а
+  {0x3C, 0x4A, 0x4A, 0x4A, 0x30, 0x00},  // U+0431 б
+  {0x7C, 0x54, 0x54, 0x54, 0x28, 0x00},  // U+0432 в
+  {0x7C, 0x04, 0x04, 0x04, 0x00, 0x00},  // U+0433 г
+  {0xC0, 0x78, 0x44, 0x7C, 0xC0, 0x00},  // U+0434 д
+  {0x38, 0x54, 0x54, 0x54, 0x18, 0x00},  // U+0435 е
+  {0x44, 0x28, 0x7C, 0x28, 0x44, 0x00},  // U+0436 ж
+  {0x28, 0x44, 0x54, 0x54, 0x28, 0x00},  // U+0437 з
+  {0x7C, 0x20, 0x10, 0x08, 0x7C, 0x00},  // U+0438 и
+  {0x7C, 0x20, 0x16, 0x08, 0x7C, 0x00},  // U+0439 й
+  {0x7C, 0x10, 0x28, 0x44, 0x00, 0x00},  // U+043A к
+  {0x70, 0x08, 0x04, 0x04, 0x7C, 0x00},  // U+043B л
+  {0x7C, 0x04, 0x18, 0x04, 0x7C, 0x00},  // U+043C м
+  {0x7C, 0x10, 0x10, 0x10, 0x7C, 0x00},  // U+043D н
+  {0x38, 0x44, 0x44, 0x44, 0x38, 0x00},  // U+043E о
+  {0x7C, 0x04, 0x04, 0x04, 0x7C, 0x00},  // U+043F п
+  {0xFC, 0x24, 0x24, 0x24, 0x18, 0x00},  // U+0440 р
+  {0x38, 0x44, 0x44, 0x44, 0x28, 0x00},  // U+0441 с
+  {0x04, 0x04, 0x7C, 0x04, 0x04, 0x00},  // U+0442 т
+  {0x0C, 0x50, 0x50, 0x50, 0x3C, 0x00},  // U+0443 у
+  {0x38, 0x44, 0xFE, 0x44, 0x38, 0x00},  // U+0444 ф
+  {0x44, 0x28, 0x10, 0x28, 0x44, 0x00},  // U+0445 х
+  {0x7C, 0x40, 0x40, 0x7C, 0xC0, 0x00},  // U+0446 ц
+  {0x0C, 0x10, 0x10, 0x10, 0x7C, 0x00},  // U+0447 ч
+  {0x7C, 0x40, 0x7C, 0x40, 0x7C, 0x00},  // U+0448 ш
+  {0x7C, 0x40, 0x7C, 0x40, 0xFC, 0x00},  // U+0449 щ
+  {0x04, 0x7C, 0x50, 0x50, 0x20, 0x00},  // U+044A ъ
+  {0x7C, 0x50, 0x20, 0x00, 0x7C, 0x00},  // U+044B ы
+  {0x7C, 0x50, 0x50, 0x50, 0x20, 0x00},  // U+044C ь
+  {0x28, 0x44, 0x54, 0x54, 0x38, 0x00},  // U+044D э
+  {0x7C, 0x10, 0x38, 0x44, 0x38, 0x00},  // U+044E ю
+  {0x48, 0x34, 0x14, 0x14, 0x7C, 0x00},  // U+044F я
+  {0x38, 0x55, 0x56, 0x54, 0x18, 0x00},  // U+0450 ѐ
+  {0x38, 0x55, 0x54, 0x55, 0x18, 0x00},  // U+0451 ё
+  {0x02, 0x7F, 0x0A, 0x88, 0x70, 0x00},  // U+0452 ђ
+  {0x7C, 0x04, 0x06, 0x05, 0x00, 0x00},  // U+0453 ѓ
+  {0x38, 0x54, 0x54, 0x54, 0x00, 0x00},  // U+0454 є
+  {0x48, 0x54, 0x54, 0x54, 0x24, 0x00},  // U+0455 ѕ
+  {0x00, 0x44, 0x7D, 0x40, 0x00, 0x00},  // U+0456 і
+  {0x00, 0x45, 0x7C, 0x41, 0x00, 0x00},  // U+0457 ї
+  {0x20, 0x40, 0x40, 0x3D, 0x00, 0x00},  // U+0458 ј
+  {0x40, 0x3C, 0x04, 0x7C, 0x50, 0x20},  // U+0459 љ
+  {0x7C, 0x10, 0x10, 0x7C, 0x50, 0x20},  // U+045A њ
+  {0x02, 0x7F, 0x0A, 0x08, 0x70, 0x00},  // U+045B ћ
+  {0x7C, 0x10, 0x2A, 0x45, 0x00, 0x00},  // U+045C ќ
+  {0x7C, 0x21, 0x12, 0x08, 0x7C, 0x00},  // U+045D ѝ
+  {0x0C, 0x51, 0x52, 0x51, 0x3C, 0x00},  // U+045E ў
+  {0x7C, 0x40, 0xC0, 0x40, 0x7C, 0x00},  // U+045F џ
+  {0x7E, 0x02, 0x02, 0x02, 0x03, 0x00},  // U+0490 Ґ
+  {0x7C, 0x04, 0x04, 0x06, 0x00, 0x00},  // U+0491 ґ
+  {0x08, 0x08, 0x08, 0x08, 0x08, 0x08},  // U+2500 ─
+  {0x18, 0x18, 0x18, 0x18, 0x18, 0x18},  // U+2501 ━
+  {0x00, 0x00, 0xFF, 0x00, 0x00, 0x00},  // U+2502 │
+  {0x00, 0x00, 0xFF, 0xFF, 0x00, 0x00},  // U+2503 ┃
+  {0x08, 0x00, 0x08, 0x00, 0x08, 0x00},  // U+2504 ┄
+  {0x18, 0x00, 0x18, 0x00, 0x18, 0x00},  // U+2505 ┅
+  {0x00, 0x00, 0x5B, 0x00, 0x00, 0x00},  // U+2506 ┆
+  {0x00, 0x00, 0x5B, 0x5B, 0x00, 0x00},  // U+2507 ┇
+  {0x08, 0x00, 0x08, 0x00, 0x08, 0x00},  // U+2508 ┈
+  {0x18, 0x00, 0x18, 0x00, 0x18, 0x00},  // U+2509 ┉
+  {0x00, 0x00, 0x55, 0x00, 0x00, 0x00},  // U+250A ┊
+  {0x00, 0x00, 0x55, 0x55, 0x00, 0x00},  // U+250B ┋
+  {0x00, 0x00, 0xF8, 0x08, 0x08, 0x08},  // U+250C ┌
+  {0x00, 0x00, 0xF8, 0x18, 0x18, 0x18},  // U+250D ┍
+  {0x00, 0x00, 0xF8, 0xF8, 0x08, 0x08},  // U+250E ┎
+  {0x00, 0x00, 0xF8, 0xF8, 0x18, 0x18},  // U+250F ┏
+  {0x08, 0x08, 0xF8, 0x00, 0x00, 0x00},  // U+2510 ┐
+  {0x18, 0x18, 0xF8, 0x00, 0x00, 0x00},  // U+2511 ┑
+  {0x08, 0x08, 0xF8, 0xF8, 0x00, 0x00},  // U+2512 ┒
+  {0x18, 0x18, 0xF8, 0xF8, 0x00, 0x00},  // U+2513 ┓
+  {0x00, 0x00, 0x0F, 0x08, 0x08, 0x08},  // U+2514 └
+  {0x00, 0x00, 0x1F, 0x18, 0x18, 0x18},  // U+2515 ┕
+  {0x00, 0x00, 0x0F, 0x0F, 0x08, 0x08},  // U+2516 ┖
+  {0x00, 0x00, 0x1F, 0x1F, 0x18, 0x18},  // U+2517 ┗
+  {0x08, 0x08, 0x0F, 0x00, 0x00, 0x00},  // U+2518 ┘
+  {0x18, 0x18, 0x1F, 0x00, 0x00, 0x00},  // U+2519 ┙
+  {0x08, 0x08, 0x0F, 0x0F, 0x00, 0x00},  // U+251A ┚
+  {0x18, 0x18, 0x1F, 0x1F, 0x00, 0x00},  // U+251B ┛
+  {0x00, 0x00, 0xFF, 0x08, 0x08, 0x08},  // U+251C ├
+  {0x00, 0x00, 0xFF, 0x18, 0x18, 0x18},  // U+251D ┝
+  {0x00, 0x00, 0xFF, 0x0F, 0x08, 0x08},  // U+251E ┞
+  {0x00, 0x00, 0xFF, 0xF8, 0x08, 0x08},  // U+251F ┟
+  {0x00, 0x00, 0xFF, 0xFF, 0x08, 0x08},  // U+2520 ┠
+  {0x00, 0x00, 0xFF, 0x1F, 0x18, 0x18},  // U+2521 ┡
+  {0x00, 0x00, 0xFF, 0xF8, 0x18, 0x18},  // U+2522 ┢
+  {0x00, 0x00, 0xFF, 0xFF, 0x18, 0x18},  // U+2523 ┣
+  {0x08, 0x08, 0xFF, 0x00, 0x00, 0x00},  // U+2524 ┤
+  {0x18, 0x18, 0xFF, 0x00, 0x00, 0x00},  // U+2525 ┥
+  {0x08, 0x08, 0xFF, 0x0F, 0x00, 0x00},  // U+2526 ┦
+  {0x08, 0x08, 0xFF, 0xF8, 0x00, 0x00},  // U+2527 ┧
+  {0x08, 0x08, 0xFF, 0xFF, 0x00, 0x00},  // U+2528 ┨
+  {0x18, 0x18, 0xFF, 0x1F, 0x00, 0x00},  // U+2529 ┩
+  {0x18, 0x18, 0xFF, 0xF8, 0x00, 0x00},  // U+252A ┪
+  {0x18, 0x18, 0xFF, 0xFF, 0x00, 0x00},  // U+252B ┫
+  {0x08, 0x08, 0xF8, 0x08, 0x08, 0x08},  // U+252C ┬
+  {0x18, 0x18, 0xF8, 0x08, 0x08, 0x08},  // U+252D ┭
+  {0x08, 0x08, 0xF8, 0x18, 0x18, 0x18},  // U+252E ┮
+  {0x18, 0x18, 0xF8, 0x18, 0x18, 0x18},  // U+252F ┯
+  {0x08, 0x08, 0xF8, 0xF8, 0x08, 0x08},  // U+2530 ┰
+  {0x18, 0x18, 0xF8, 0xF8, 0x08, 0x08},  // U+2531 ┱
+  {0x08, 0x08, 0xF8, 0xF8, 0x18, 0x18},  // U+2532 ┲
+  {0x18, 0x18, 0xF8, 0xF8, 0x18, 0x18},  // U+2533 ┳
+  {0x08, 0x08, 0x0F, 0x08, 0x08, 0x08},  // U+2534 ┴
+  {0x18, 0x18, 0x1F, 0x08, 0x08, 0x08},  // U+2535 ┵
+  {0x08, 0x08, 0x1F, 0x18, 0x18, 0x18},  // U+2536 ┶
+  {0x18, 0x18, 0x1F, 0x18, 0x18, 0x18},  // U+2537 ┷
+  {0x08, 0x08, 0x0F, 0x0F, 0x08, 0x08},  // U+2538 ┸
+  {0x18, 0x18, 0x1F, 0x1F, 0x08, 0x08},  // U+2539 ┹
+  {0x08, 0x08, 0x1F, 0x1F, 0x18, 0x18},  // U+253A ┺
+  {0x18, 0x18, 0x1F, 0x1F, 0x18, 0x18},  // U+253B ┻
+  {0x08, 0x08, 0xFF, 0x08, 0x08, 0x08},  // U+253C ┼
+  {0x18, 0x18, 0xFF, 0x08, 0x08, 0x08},  // U+253D ┽
+  {0x08, 0x08, 0xFF, 0x18, 0x18, 0x18},  // U+253E ┾
+  {0x18, 0x18, 0xFF, 0x18, 0x18, 0x18},  // U+253F ┿
+  {0x08, 0x08, 0xFF, 0x0F, 0x08, 0x08},  // U+2540 ╀
+  {0x08, 0x08, 0xFF, 0xF8, 0x08, 0x08},  // U+2541 ╁
+  {0x08, 0x08, 0xFF, 0xFF, 0x08, 0x08},  // U+2542 ╂
+  {0x18, 0x18, 0xFF, 0x1F, 0x08, 0x08},  // U+2543 ╃
+  {0x08, 0x08, 0xFF, 0x1F, 0x18, 0x18},  // U+2544 ╄
+  {0x18, 0x18, 0xFF, 0xF8, 0x08, 0x08},  // U+2545 ╅
+  {0x08, 0x08, 0xFF, 0xF8, 0x18, 0x18},  // U+2546 ╆
+  {0x18, 0x18, 0xFF, 0x1F, 0x18, 0x18},  // U+2547 ╇
+  {0x18, 0x18, 0xFF, 0xF8, 0x18, 0x18},  // U+2548 ╈
+  {0x18, 0x18, 0xFF, 0xFF, 0x08, 0x08},  // U+2549 ╉
+  {0x08, 0x08, 0xFF, 0xFF, 0x18, 0x18},  // U+254A ╊
+  {0x18, 0x18, 0xFF, 0xFF, 0x18, 0x18},  // U+254B ╋
+  {0x08, 0x08, 0x00, 0x08, 0x08, 0x00},  // U+254C ╌
+  {0x18, 0x18, 0x00, 0x18, 0x18, 0x00},  // U+254D ╍
+  {0x00, 0x00, 0x77, 0x00, 0x00, 0x00},  // U+254E ╎
+  {0x00, 0x00, 0x77, 0x77, 0x00, 0x00},  // U+254F ╏
+  {0x14, 0x14, 0x14, 0x14, 0x14, 0x14},  // U+2550 ═
+  {0x00, 0xFF, 0x00, 0xFF, 0x00, 0x00},  // U+2551 ║
+  {0x00, 0x00, 0xFC, 0x14, 0x14, 0x14},  // U+2552 ╒
+  {0x00, 0xF8, 0x08, 0xF8, 0x08, 0x08},  // U+2553 ╓
+  {0x00, 0xFC, 0x04, 0xF4, 0x14, 0x14},  // U+2554 ╔
+  {0x14, 0x14, 0xFC, 0x00, 0x00, 0x00},  // U+2555 ╕
+  {0x08, 0xF8, 0x08, 0xF8, 0x00, 0x00},  // U+2556 ╖
+  {0x14, 0xF4, 0x04, 0xFC, 0x00, 0x00},  // U+2557 ╗
+  {0x00, 0x00, 0x1F, 0x14, 0x14, 0x14},  // U+2558 ╘
+  {0x00, 0x0F, 0x08, 0x0F, 0x08, 0x08},  // U+2559 ╙
+  {0x00, 0x1F, 0x10, 0x17, 0x14, 0x14},  // U+255A ╚
+  {0x14, 0x14, 0x1F, 0x00, 0x00, 0x00},  // U+255B ╛
+  {0x08, 0x0F, 0x08, 0x0F, 0x00, 0x00},  // U+255C ╜
+  {0x14, 0x17, 0x10, 0x1F, 0x00, 0x00},  // U+255D ╝
+  {0x00, 0x00, 0xFF, 0x14, 0x14, 0x14},  // U+255E ╞
+  {0x00, 0xFF, 0x00, 0xFF, 0x08, 0x08},  // U+255F ╟
+  {0x00, 0xFF, 0x00, 0xF7, 0x14, 0x14},  // U+2560 ╠
+  {0x14, 0x14, 0xFF, 0x00, 0x00, 0x00},  // U+2561 ╡
+  {0x08, 0xFF, 0x00, 0xFF, 0x00, 0x00},  // U+2562 ╢
+  {0x14, 0xF7, 0x00, 0xFF, 0x00, 0x00},  // U+2563 ╣
+  {0x14, 0x14, 0xF4, 0x14, 0x14, 0x14},  // U+2564 ╤
+  {0x08, 0xF8, 0x08, 0xF8, 0x08, 0x08},  // U+2565 ╥
+  {0x14, 0xF4, 0x04, 0xF4, 0x14, 0x14},  // U+2566 ╦
+  {0x14, 0x14, 0x17, 0x14, 0x14, 0x14},  // U+2567 ╧
+  {0x08, 0x0F, 0x08, 0x0F, 0x08, 0x08},  // U+2568 ╨
+  {0x14, 0x17, 0x10, 0x17, 0x14, 0x14},  // U+2569 ╩
+  {0x14, 0x14, 0xF7, 0x14, 0x14, 0x14},  // U+256A ╪
+  {0x08, 0xFF, 0x00, 0xFF, 0x08, 0x08},  // U+256B ╫
+  {0x14, 0xF7, 0x00, 0xF7, 0x14, 0x14},  // U+256C ╬
+  {0x00, 0x00, 0xF0, 0x08, 0x08, 0x08},  // U+256D ╭
+  {0x08, 0x08, 0xF0, 0x00, 0x00, 0x00},  // U+256E ╮
+  {0x08, 0x08, 0x07, 0x00, 0x00, 0x00},  // U+256F ╯
+  {0x00, 0x00, 0x07, 0x08, 0x08, 0x08},  // U+2570 ╰
+  {0x80, 0x40, 0x30, 0x08, 0x04, 0x03},  // U+2571 ╱
+  {0x03, 0x04, 0x08, 0x30, 0x40, 0x80},  // U+2572 ╲
+  {0x83, 0x44, 0x38, 0x38, 0x44, 0x83},  // U+2573 ╳
+  {0x08, 0x08, 0x08, 0x00, 0x00, 0x00},  // U+2574 ╴
+  {0x00, 0x00, 0x0F, 0x00, 0x00, 0x00},  // U+2575 ╵
+  {0x00, 0x00, 0x08, 0x08, 0x08, 0x08},  // U+2576 ╶
+  {0x00, 0x00, 0xF8, 0x00, 0x00, 0x00},  // U+2577 ╷
+  {0x18, 0x18, 0x18, 0x00, 0x00, 0x00},  // U+2578 ╸
+  {0x00, 0x00, 0x0F, 0x0F, 0x00, 0x00},  // U+2579 ╹
+  {0x00, 0x00, 0x18, 0x18, 0x18, 0x18},  // U+257A ╺
+  {0x00, 0x00, 0xF8, 0xF8, 0x00, 0x00},  // U+257B ╻
+  {0x08, 0x08, 0x18, 0x18, 0x18, 0x18},  // U+257C ╼
+  {0x00, 0x00, 0xFF, 0xF8, 0x00, 0x00},  // U+257D ╽
+  {0x18, 0x18, 0x18, 0x08, 0x08, 0x08},  // U+257E ╾
+  {0x00, 0x00, 0xFF, 0x0F, 0x00, 0x00},  // U+257F ╿
+  {0x0F, 0x0F, 0x0F, 0x0F, 0x0F, 0x0F},  // U+2580 ▀
+  {0x80, 0x80, 0x80, 0x80, 0x80, 0x80},  // U+2581 ▁
+  {0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0},  // U+2582 ▂
+  {0xE0, 0xE0, 0xE0, 0xE0, 0xE0, 0xE0},  // U+2583 ▃
+  {0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0},  // U+2584 ▄
+  {0xF8, 0xF8, 0xF8, 0xF8, 0xF8, 0xF8},  // U+2585 ▅
+  {0xFC, 0xFC, 0xFC, 0xFC, 0xFC, 0xFC},  // U+2586 ▆
+  {0xFE, 0xFE, 0xFE, 0xFE, 0xFE, 0xFE},  // U+2587 ▇
+  {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF},  // U+2588 █
+  {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00},  // U+2589 ▉
+  {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00},  // U+258A ▊
+  {0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00},  // U+258B ▋
+  {0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00},  // U+258C ▌
+  {0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00},  // U+258D ▍
+  {0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00},  // U+258E ▎
+  {0xFF, 0x00, 0x00, 0x00, 0x00, 0x00},  // U+258F ▏
+  {0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF},  // U+2590 ▐
+  {0x55, 0x00, 0x55, 0x00, 0x55, 0x00},  // U+2591 ░
+  {0x55, 0xAA, 0x55, 0xAA, 0x55, 0xAA},  // U+2592 ▒
+  {0xFF, 0x55, 0xFF, 0x55, 0xFF, 0x55},  // U+2593 ▓
+  {0x01, 0x01, 0x01, 0x01, 0x01, 0x01},  // U+2594 ▔
+  {0x00, 0x00, 0x00, 0x00, 0x00, 0xFF},  // U+2595 ▕
+  {0xF0, 0xF0, 0xF0, 0x00, 0x00, 0x00},  // U+2596 ▖
+  {0x00, 0x00, 0x00, 0xF0, 0xF0, 0xF0},  // U+2597 ▗
+  {0x0F, 0x0F, 0x0F, 0x00, 0x00, 0x00},  // U+2598 ▘
+  {0xFF, 0xFF, 0xFF, 0xF0, 0xF0, 0xF0},  // U+2599 ▙
+  {0x0F, 0x0F, 0x0F, 0xF0, 0xF0, 0xF0},  // U+259A ▚
+  {0xFF, 0xFF, 0xFF, 0x0F, 0x0F, 0x0F},  // U+259B ▛
+  {0x0F, 0x0F, 0x0F, 0xFF, 0xFF, 0xFF},  // U+259C ▜
+  {0x00, 0x00, 0x00, 0x0F, 0x0F, 0x0F},  // U+259D ▝
+  {0xF0, 0xF0, 0xF0, 0x0F, 0x0F, 0x0F},  // U+259E ▞
+  {0xF0, 0xF0, 0xF0, 0xFF, 0xFF, 0xFF},  // U+259F ▟
+};
+
+// 4x6 cells: 4 column bytes per font index, LSB at top
+static const uint8_t glyphAtlas4x6[GLYPH_ATLAS_COUNT][4] PROGMEM = {
+  {0x00, 0x00, 0x00, 0x00},  // U+0000
+  {0x00, 0x00, 0x00, 0x00},  // U+0001
+  {0x00, 0x00, 0x00, 0x00},  // U+0002
+  {0x00, 0x00, 0x00, 0x00},  // U+0003
+  {0x00, 0x00, 0x00, 0x00},  // U+0004
+  {0x00, 0x00, 0x00, 0x00},  // U+0005
+  {0x00, 0x00, 0x00, 0x00},  // U+0006
+  {0x00, 0x00, 0x00, 0x00},  // U+0007
+  {0x00, 0x00, 0x00, 0x00},  // U+0008
+  {0x00, 0x00, 0x00, 0x00},  // U+0009
+  {0x00, 0x00, 0x00, 0x00},  // U+000A
+  {0x00, 0x00, 0x00, 0x00},  // U+000B
+  {0x00, 0x00, 0x00, 0x00},  // U+000C
+  {0x00, 0x00, 0x00, 0x00},  // U+000D
+  {0x00, 0x00, 0x00, 0x00},  // U+000E
+  {0x00, 0x00, 0x00, 0x00},  // U+000F
+  {0x00, 0x00, 0x00, 0x00},  // U+0010
+  {0x00, 0x00, 0x00, 0x00},  // U+0011
+  {0x00, 0x00, 0x00, 0x00},  // U+0012
+  {0x00, 0x00, 0x00, 0x00},  // U+0013
+  {0x00, 0x00, 0x00, 0x00},  // U+0014
+  {0x00, 0x00, 0x00, 0x00},  // U+0015
+  {0x00, 0x00, 0x00, 0x00},  // U+0016
+  {0x00, 0x00, 0x00, 0x00},  // U+0017
+  {0x00, 0x00, 0x00, 0x00},  // U+0018
+  {0x00, 0x00, 0x00, 0x00},  // U+0019
+  {0x00, 0x00, 0x00, 0x00},  // U+001A
+  {0x00, 0x00, 0x00, 0x00},  // U+001B
+  {0x00, 0x00, 0x00, 0x00},  // U+001C
+  {0x00, 0x00, 0x00, 0x00},  // U+001D
+  {0x00, 0x00, 0x00, 0x00},  // U+001E
+  {0x00, 0x00, 0x00, 0x00},  // U+001F
+  {0x00, 0x00, 0x00, 0x00},  // U+0020
+  {0x00, 0x17, 0x00, 0x00},  // U+0021 !
+  {0x03, 0x00, 0x03, 0x00},  // U+0022 "
+  {0x1F, 0x0A, 0x1F, 0x00},  // U+0023 #
+  {0x12, 0x1F, 0x09, 0x00},  // U+0024 $
+  {0x19, 0x04, 0x13, 0x00},  // U+0025 %
+  {0x0B, 0x17, 0x1C, 0x00},  // U+0026 &
+  {0x00, 0x03, 0x00, 0x00},  // U+0027 '
+  {0x00, 0x0E, 0x11, 0x00},  // U+0028 (
+  {0x11, 0x0E, 0x00, 0x00},  // U+0029 )
+  {0x0A, 0x04, 0x0A, 0x00},  // U+002A *
+  {0x04, 0x0E, 0x04, 0x00},  // U+002B +
+  {0x20, 0x10, 0x00, 0x00},  // U+002C ,
+  {0x04, 0x04, 0x04, 0x00},  // U+002D -
+  {0x00, 0x10, 0x00, 0x00},  // U+002E .
+  {0x18, 0x04, 0x03, 0x00},  // U+002F /
+  {0x1F, 0x11, 0x1F, 0x00},  // U+0030 0
+  {0x12, 0x1F, 0x10, 0x00},  // U+0031 1
+  {0x19, 0x15, 0x12, 0x00},  // U+0032 2
+  {0x11, 0x15, 0x0A, 0x00},  // U+0033 3
+  {0x07, 0x04, 0x1F, 0x00},  // U+0034 4
+  {0x17, 0x15, 0x09, 0x00},  // U+0035 5
+  {0x1E, 0x15, 0x1D, 0x00},  // U+0036 6
+  {0x01, 0x1D, 0x03, 0x00},  // U+0037 7
+  {0x1F, 0x15, 0x1F, 0x00},  // U+0038 8
+  {0x17, 0x15, 0x0F, 0x00},  // U+0039 9
+  {0x00, 0x0A, 0x00, 0x00},  // U+003A :
+  {0x10, 0x0A, 0x00, 0x00},  // U+003B ;
+  {0x04, 0x0A, 0x11, 0x00},  // U+003C <
+  {0x0A, 0x0A, 0x0A, 0x00},  // U+003D =
+  {0x11, 0x0A, 0x04, 0x00},  // U+003E >
+  {0x01, 0x15, 0x02, 0x00},  // U+003F ?
+  {0x0E, 0x15, 0x16, 0x00},  // U+0040 @
+  {0x1E, 0x05, 0x1E, 0x00},  // U+0041 A
+  {0x1F, 0x15, 0x0A, 0x00},  // U+0042 B
+  {0x0E, 0x11, 0x11, 0x00},  // U+0043 C
+  {0x1F, 0x11, 0x0E, 0x00},  // U+0044 D
+  {0x1F, 0x15, 0x15, 0x00},  // U+0045 E
+  {0x1F, 0x05, 0x05, 0x00},  // U+0046 F
+  {0x0E, 0x11, 0x1D, 0x00},  // U+0047 G
+  {0x1F, 0x04, 0x1F, 0x00},  // U+0048 H
+  {0x11, 0x1F, 0x11, 0x00},  // U+0049 I
+  {0x08, 0x10, 0x0F, 0x00},  // U+004A J
+  {0x1F, 0x04, 0x1B, 0x00},  // U+004B K
+  {0x1F, 0x10, 0x10, 0x00},  // U+004C L
+  {0x1F, 0x06, 0x1F, 0x00},  // U+004D M
+  {0x1F, 0x0E, 0x1F, 0x00},  // U+004E N
+  {0x0E, 0x11, 0x0E, 0x00},  // U+004F O
+  {0x1F, 0x05, 0x02, 0x00},  // U+0050 P
+  {0x0E, 0x19, 0x1E, 0x00},  // U+0051 Q
+  {0x1F, 0x05, 0x1A, 0x00},  // U+0052 R
+  {0x12, 0x15, 0x09, 0x00},  // U+0053 S
+  {0x01, 0x1F, 0x01, 0x00},  // U+0054 T
+  {0x1F, 0x10, 0x1F, 0x00},  // U+0055 U
+  {0x07, 0x18, 0x07, 0x00},  // U+0056 V
+  {0x1F, 0x0C, 0x1F, 0x00},  // U+0057 W
+  {0x1B, 0x04, 0x1B, 0x00},  // U+0058 X
+  {0x03, 0x1C, 0x03, 0x00},  // U+0059 Y
+  {0x19, 0x15, 0x13, 0x00},  // U+005A Z
+  {0x1F, 0x11, 0x00, 0x00},  // U+005B [
+  {0x03, 0x04, 0x18, 0x00},  // U+005C backslash
+  {0x00, 0x11, 0x1F, 0x00},  // U+005D ]
+  {0x02, 0x01, 0x02, 0x00},  // U+005E ^
+  {0x10, 0x10, 0x10, 0x00},  // U+005F _
+  {0x01, 0x02, 0x00, 0x00},  // U+0060 `
+  {0x1A, 0x16, 0x1C, 0x00},  // U+0061 a
+  {0x1F, 0x12, 0x0C, 0x00},  // U+0062 b
+  {0x0C, 0x12, 0x12, 0x00},  // U+0063 c
+  {0x0C, 0x12, 0x1F, 0x00},  // U+0064 d
+  {0x0C, 0x16, 0x16, 0x00},  // U+0065 e
+  {0x04, 0x1E, 0x05, 0x00},  // U+0066 f
+  {0x24, 0x2A, 0x1E, 0x00},  // U+0067 g
+  {0x1F, 0x02, 0x1C, 0x00},  // U+0068 h
+  {0x00, 0x1D, 0x00, 0x00},  // U+0069 i
+  {0x10, 0x20, 0x1D, 0x00},  // U+006A j
+  {0x1F, 0x0C, 0x12, 0x00},  // U+006B k
+  {0x11, 0x1F, 0x10, 0x00},  // U+006C l
+  {0x1E, 0x0E, 0x1E, 0x00},  // U+006D m
+  {0x1E, 0x02, 0x1C, 0x00},  // U+006E n
+  {0x0C, 0x12, 0x0C, 0x00},  // U+006F o
+  {0x3E, 0x12, 0x0C, 0x00},  // U+0070 p
+  {0x0C, 0x12, 0x3E, 0x00},  // U+0071 q
+  {0x1C, 0x02, 0x02, 0x00},  // U+0072 r
+  {0x14, 0x1E, 0x0A, 0x00},  // U+0073 s
+  {0x02, 0x1F, 0x12, 0x00},  // U+0074 t
+  {0x0E, 0x10, 0x1E, 0x00},  // U+0075 u
+  {0x0E, 0x18, 0x0E, 0x00},  // U+0076 v
+  {0x1E, 0x1C, 0x1E, 0x00},  // U+0077 w
+  {0x12, 0x0C, 0x12, 0x00},  // U+0078 x
+  {0x26, 0x28, 0x1E, 0x00},  // U+0079 y
+  {0x1A, 0x1E, 0x16, 0x00},  // U+007A z
+  {0x04, 0x1F, 0x11, 0x00},  // U+007B {
+  {0x00, 0x1F, 0x00, 0x00},  // U+007C |
+  {0x11, 0x1F, 0x04, 0x00},  // U+007D }
+  {0x04, 0x06, 0x02, 0x00},  // U+007E ~
+  {0x0E, 0x09, 0x0E, 0x00},  // U+007F
+  {0x00, 0x00, 0x00, 0x00},  // U+00A0
+  {0x00, 0x1D, 0x00, 0x00},  // U+00A1 ¡
+  {0x04, 0x1B, 0x0A, 0x00},  // U+00A2 ¢
+  {0x14, 0x1F, 0x15, 0x00},  // U+00A3 £
+  {0x15, 0x0A, 0x15, 0x00},  // U+00A4 ¤
+  {0x05, 0x1E, 0x05, 0x00},  // U+00A5 ¥
+  {0x00, 0x1B, 0x00, 0x00},  // U+00A6 ¦
+  {0x16, 0x1B, 0x0D, 0x00},  // U+00A7 §
+  {0x01, 0x00, 0x01, 0x00},  // U+00A8 ¨
+  {0x0F, 0x0F, 0x09, 0x00},  // U+00A9 ©
+  {0x12, 0x15, 0x17, 0x00},  // U+00AA ª
+  {0x04, 0x0E, 0x0A, 0x00},  // U+00AB «
+  {0x04, 0x04, 0x0C, 0x00},  // U+00AC ¬
+  {0x04, 0x04, 0x00, 0x00},  // U+00AD
+  {0x0F, 0x05, 0x0B, 0x00},  // U+00AE ®
+  {0x01, 0x01, 0x01, 0x00},  // U+00AF ¯
+  {0x02, 0x05, 0x02, 0x00},  // U+00B0 °
+  {0x12, 0x17, 0x12, 0x00},  // U+00B1 ±
+  {0x01, 0x07, 0x04, 0x00},  // U+00B2 ²
+  {0x05, 0x07, 0x00, 0x00},  // U+00B3 ³
+  {0x00, 0x02, 0x01, 0x00},  // U+00B4 ´
+  {0x3E, 0x10, 0x1E, 0x00},  // U+00B5 µ
+  {0x02, 0x1F, 0x1F, 0x00},  // U+00B6 ¶
+  {0x00, 0x04, 0x00, 0x00},  // U+00B7 ·
+  {0x20, 0x30, 0x00, 0x00},  // U+00B8 ¸
+  {0x02, 0x07, 0x00, 0x00},  // U+00B9 ¹
+  {0x12, 0x15, 0x12, 0x00},  // U+00BA º
+  {0x0A, 0x0E, 0x04, 0x00},  // U+00BB »
+  {0x03, 0x0C, 0x18, 0x00},  // U+00BC ¼
+  {0x03, 0x14, 0x1C, 0x00},  // U+00BD ½
+  {0x03, 0x0F, 0x18, 0x00},  // U+00BE ¾
+  {0x08, 0x15, 0x10, 0x00},  // U+00BF ¿
+  {0x1D, 0x0A, 0x1C, 0x00},  // U+00C0 À
+  {0x1C, 0x0A, 0x1D, 0x00},  // U+00C1 Á
+  {0x1C, 0x0B, 0x1C, 0x00},  // U+00C2 Â
+  {0x1D, 0x0B, 0x1C, 0x00},  // U+00C3 Ã
+  {0x1D, 0x0A, 0x1D, 0x00},  // U+00C4 Ä
+  {0x1D, 0x0B, 0x1D, 0x00},  // U+00C5 Å
+  {0x1E, 0x1F, 0x15, 0x00},  // U+00C6 Æ
+  {0x0E, 0x31, 0x11, 0x00},  // U+00C7 Ç
+  {0x1F, 0x16, 0x12, 0x00},  // U+00C8 È
+  {0x1E, 0x16, 0x13, 0x00},  // U+00C9 É
+  {0x1E, 0x17, 0x12, 0x00},  // U+00CA Ê
+  {0x1F, 0x16, 0x13, 0x00},  // U+00CB Ë
+  {0x13, 0x1E, 0x12, 0x00},  // U+00CC Ì
+  {0x12, 0x1E, 0x13, 0x00},  // U+00CD Í
+  {0x12, 0x1F, 0x12, 0x00},  // U+00CE Î
+  {0x13, 0x1E, 0x13, 0x00},  // U+00CF Ï
+  {0x1F, 0x15, 0x0E, 0x00},  // U+00D0 Ð
+  {0x1F, 0x0D, 0x1E, 0x00},  // U+00D1 Ñ
+  {0x0D, 0x12, 0x0C, 0x00},  // U+00D2 Ò
+  {0x0C, 0x12, 0x0D, 0x00},  // U+00D3 Ó
+  {0x0C, 0x13, 0x0C, 0x00},  // U+00D4 Ô
+  {0x0D, 0x13, 0x0C, 0x00},  // U+00D5 Õ
+  {0x0D, 0x12, 0x0D, 0x00},  // U+00D6 Ö
+  {0x14, 0x08, 0x14, 0x00},  // U+00D7 ×
+  {0x1E, 0x15, 0x0F, 0x00},  // U+00D8 Ø
+  {0x1F, 0x10, 0x1E, 0x00},  // U+00D9 Ù
+  {0x1E, 0x10, 0x1F, 0x00},  // U+00DA Ú
+  {0x1E, 0x11, 0x1E, 0x00},  // U+00DB Û
+  {0x1F, 0x10, 0x1F, 0x00},  // U+00DC Ü
+  {0x06, 0x18, 0x07, 0x00},  // U+00DD Ý
+  {0x1F, 0x0A, 0x04, 0x00},  // U+00DE Þ
+  {0x3F, 0x15, 0x0A, 0x00},  // U+00DF ß
+  {0x1B, 0x16, 0x1C, 0x00},  // U+00E0 à
+  {0x1A, 0x16, 0x1D, 0x00},  // U+00E1 á
+  {0x1A, 0x17, 0x1C, 0x00},  // U+00E2 â
+  {0x1B, 0x17, 0x1C, 0x00},  // U+00E3 ã
+  {0x1B, 0x16, 0x1D, 0x00},  // U+00E4 ä
+  {0x1B, 0x17, 0x1D, 0x00},  // U+00E5 å
+  {0x0C, 0x1E, 0x16, 0x00},  // U+00E6 æ
+  {0x0C, 0x32, 0x12, 0x00},  // U+00E7 ç
+  {0x0D, 0x16, 0x16, 0x00},  // U+00E8 è
+  {0x0C, 0x16, 0x17, 0x00},  // U+00E9 é
+  {0x0C, 0x17, 0x16, 0x00},  // U+00EA ê
+  {0x0D, 0x16, 0x17, 0x00},  // U+00EB ë
+  {0x01, 0x1C, 0x00, 0x00},  // U+00EC ì
+  {0x00, 0x1C, 0x01, 0x00},  // U+00ED í
+  {0x00, 0x1D, 0x00, 0x00},  // U+00EE î
+  {0x01, 0x1C, 0x01, 0x00},  // U+00EF ï
+  {0x0A, 0x17, 0x0D, 0x00},  // U+00F0 ð
+  {0x1F, 0x03, 0x1C, 0x00},  // U+00F1 ñ
+  {0x0D, 0x12, 0x0C, 0x00},  // U+00F2 ò
+  {0x0C, 0x12, 0x0D, 0x00},  // U+00F3 ó
+  {0x0C, 0x13, 0x0C, 0x00},  // U+00F4 ô
+  {0x0D, 0x13, 0x0C, 0x00},  // U+00F5 õ
+  {0x0D, 0x12, 0x0D, 0x00},  // U+00F6 ö
+  {0x04, 0x15, 0x04, 0x00},  // U+00F7 ÷
+  {0x1C, 0x12, 0x0E, 0x00},  // U+00F8 ø
+  {0x0F, 0x10, 0x1E, 0x00},  // U+00F9 ù
+  {0x0E, 0x10, 0x1F, 0x00},  // U+00FA ú
+  {0x0E, 0x11, 0x1E, 0x00},  // U+00FB û
+  {0x0F, 0x10, 0x1F, 0x00},  // U+00FC ü
+  {0x26, 0x28, 0x1F, 0x00},  // U+00FD ý
+  {0x3F, 0x12, 0x0C, 0x00},  // U+00FE þ
+  {0x27, 0x28, 0x1F, 0x00},  // U+00FF ÿ
+  {0x1F, 0x16, 0x12, 0x00},  // U+0400 Ѐ
+  {0x1F, 0x16, 0x13, 0x00},  // U+0401 Ё
+  {0x1F, 0x05, 0x39, 0x00},  // U+0402 Ђ
+  {0x1E, 0x02, 0x03, 0x00},  // U+0403 Ѓ
+  {0x0E, 0x15, 0x11, 0x00},  // U+0404 Є
+  {0x12, 0x15, 0x09, 0x00},  // U+0405 Ѕ
+  {0x11, 0x1F, 0x11, 0x00},  // U+0406 І
+  {0x13, 0x1E, 0x13, 0x00},  // U+0407 Ї
+  {0x08, 0x10, 0x0F, 0x00},  // U+0408 Ј
+  {0x1E, 0x1F, 0x18, 0x00},  // U+0409 Љ
+  {0x1F, 0x14, 0x1C, 0x00},  // U+040A Њ
+  {0x1F, 0x05, 0x19, 0x00},  // U+040B Ћ
+  {0x1E, 0x0C, 0x13, 0x00},  // U+040C Ќ
+  {0x1F, 0x08, 0x16, 0x00},  // U+040D Ѝ
+  {0x13, 0x14, 0x0F, 0x00},  // U+040E Ў
+  {0x1F, 0x30, 0x1F, 0x00},  // U+040F Џ
+  {0x1E, 0x05, 0x1E, 0x00},  // U+0410 А
+  {0x1F, 0x15, 0x09, 0x00},  // U+0411 Б
+  {0x1F, 0x15, 0x0A, 0x00},  // U+0412 В
+  {0x1F, 0x01, 0x01, 0x00},  // U+0413 Г
+  {0x3E, 0x11, 0x3E, 0x00},  // U+0414 Д
+  {0x1F, 0x15, 0x15, 0x00},  // U+0415 Е
+  {0x1B, 0x0E, 0x1B, 0x00},  // U+0416 Ж
+  {0x11, 0x15, 0x0A, 0x00},  // U+0417 З
+  {0x1F, 0x08, 0x17, 0x00},  // U+0418 И
+  {0x1E, 0x09, 0x16, 0x00},  // U+0419 Й
+  {0x1F, 0x04, 0x1B, 0x00},  // U+041A К
+  {0x1E, 0x01, 0x1F, 0x00},  // U+041B Л
+  {0x1F, 0x06, 0x1F, 0x00},  // U+041C М
+  {0x1F, 0x04, 0x1F, 0x00},  // U+041D Н
+  {0x0E, 0x11, 0x0E, 0x00},  // U+041E О
+  {0x1F, 0x01, 0x1F, 0x00},  // U+041F П
+  {0x1F, 0x05, 0x02, 0x00},  // U+0420 Р
+  {0x0E, 0x11, 0x11, 0x00},  // U+0421 С
+  {0x01, 0x1F, 0x01, 0x00},  // U+0422 Т
+  {0x13, 0x14, 0x0F, 0x00},  // U+0423 У
+  {0x0E, 0x1B, 0x0E, 0x00},  // U+0424 Ф
+  {0x1B, 0x04, 0x1B, 0x00},  // U+0425 Х
+  {0x1F, 0x10, 0x3F, 0x00},  // U+0426 Ц
+  {0x03, 0x04, 0x1F, 0x00},  // U+0427 Ч
+  {0x1F, 0x1C, 0x1F, 0x00},  // U+0428 Ш
+  {0x1F, 0x1C, 0x3F, 0x00},  // U+0429 Щ
+  {0x01, 0x1F, 0x1C, 0x00},  // U+042A Ъ
+  {0x1F, 0x14, 0x1F, 0x00},  // U+042B Ы
+  {0x1F, 0x14, 0x08, 0x00},  // U+042C Ь
+  {0x11, 0x15, 0x0E, 0x00},  // U+042D Э
+  {0x1F, 0x0A, 0x1F, 0x00},  // U+042E Ю
+  {0x1A, 0x05, 0x1F, 0x00},  // U+042F Я
+  {0x1A, 0x16, 0x1C, 0x00},  // U+0430 а
+  {0x0E, 0x15, 0x09, 0x00},  // U+0431 б
+  {0x1E, 0x16, 0x08, 0x00},  // U+0432 в
+  {0x1E, 0x02, 0x02, 0x00},  // U+0433 г
+  {0x3C, 0x12, 0x3C, 0x00},  // U+0434 д
+  {0x0C, 0x16, 0x16, 0x00},  // U+0435 е
+  {0x1A, 0x0C, 0x1A, 0x00},  // U+0436 ж
+  {0x12, 0x16, 0x08, 0x00},  // U+0437 з
+  {0x1E, 0x08, 0x16, 0x00},  // U+0438 и
+  {0x1E, 0x09, 0x16, 0x00},  // U+0439 й
+  {0x1E, 0x0C, 0x12, 0x00},  // U+043A к
+  {0x1C, 0x02, 0x1E, 0x00},  // U+043B л
+  {0x1E, 0x0C, 0x1E, 0x00},  // U+043C м
+  {0x1E, 0x04, 0x1E, 0x00},  // U+043D н
+  {0x0C, 0x12, 0x0C, 0x00},  // U+043E о
+  {0x1E, 0x02, 0x1E, 0x00},  // U+043F п
+  {0x3E, 0x12, 0x0C, 0x00},  // U+0440 р
+  {0x0C, 0x12, 0x12, 0x00},  // U+0441 с
+  {0x02, 0x1E, 0x02, 0x00},  // U+0442 т
+  {0x26, 0x28, 0x1E, 0x00},  // U+0443 у
+  {0x0E, 0x1B, 0x0E, 0x00},  // U+0444 ф
+  {0x12, 0x0C, 0x12, 0x00},  // U+0445 х
+  {0x1E, 0x10, 0x3E, 0x00},  // U+0446 ц
+  {0x06, 0x08, 0x1E, 0x00},  // U+0447 ч
+  {0x1E, 0x10, 0x1E, 0x00},  // U+0448 ш
+  {0x1E, 0x10, 0x3E, 0x00},  // U+0449 щ
+  {0x02, 0x1E, 0x18, 0x00},  // U+044A ъ
+  {0x1E, 0x18, 0x1E, 0x00},  // U+044B ы
+  {0x1E, 0x14, 0x08, 0x00},  // U+044C ь
+  {0x12, 0x16, 0x0C, 0x00},  // U+044D э
+  {0x1E, 0x14, 0x1E, 0x00},  // U+044E ю
+  {0x14, 0x0A, 0x1E, 0x00},  // U+044F я
+  {0x0D, 0x16, 0x16, 0x00},  // U+0450 ѐ
+  {0x0D, 0x16, 0x17, 0x00},  // U+0451 ё
+  {0x1F, 0x0A, 0x32, 0x00},  // U+0452 ђ
+  {0x1E, 0x02, 0x03, 0x00},  // U+0453 ѓ
+  {0x0C, 0x16, 0x12, 0x00},  // U+0454 є
+  {0x14, 0x1E, 0x0A, 0x00},  // U+0455 ѕ
+  {0x00, 0x1D, 0x00, 0x00},  // U+0456 і
+  {0x01, 0x1C, 0x01, 0x00},  // U+0457 ї
+  {0x10, 0x20, 0x1D, 0x00},  // U+0458 ј
+  {0x1C, 0x1E, 0x18, 0x00},  // U+0459 љ
+  {0x1E, 0x14, 0x1C, 0x00},  // U+045A њ
+  {0x1F, 0x0A, 0x12, 0x00},  // U+045B ћ
+  {0x1E, 0x0C, 0x13, 0x00},  // U+045C ќ
+  {0x1F, 0x08, 0x16, 0x00},  // U+045D ѝ
+  {0x27, 0x28, 0x1F, 0x00},  // U+045E ў
+  {0x1E, 0x30, 0x1E, 0x00},  // U+045F џ
+  {0x1E, 0x02, 0x03, 0x00},  // U+0490 Ґ
+  {0x1C, 0x04, 0x06, 0x00},  // U+0491 ґ
+  {0x04, 0x04, 0x04, 0x04},  // U+2500 ─
+  {0x0C, 0x0C, 0x0C, 0x0C},  // U+2501 ━
+  {0x00, 0x3F, 0x00, 0x00},  // U+2502 │
+  {0x00, 0x3F, 0x3F, 0x00},  // U+2503 ┃
+  {0x04, 0x00, 0x04, 0x00},  // U+2504 ┄
+  {0x0C, 0x00, 0x0C, 0x00},  // U+2505 ┅
+  {0x00, 0x15, 0x00, 0x00},  // U+2506 ┆
+  {0x00, 0x15, 0x15, 0x00},  // U+2507 ┇
+  {0x04, 0x00, 0x04, 0x00},  // U+2508 ┈
+  {0x0C, 0x00, 0x0C, 0x00},  // U+2509 ┉
+  {0x00, 0x15, 0x00, 0x00},  // U+250A ┊
+  {0x00, 0x15, 0x15, 0x00},  // U+250B ┋
+  {0x00, 0x3C, 0x04, 0x04},  // U+250C ┌
+  {0x00, 0x3C, 0x0C, 0x0C},  // U+250D ┍
+  {0x00, 0x3C, 0x3C, 0x04},  // U+250E ┎
+  {0x00, 0x3C, 0x3C, 0x0C},  // U+250F ┏
+  {0x04, 0x3C, 0x00, 0x00},  // U+2510 ┐
+  {0x0C, 0x3C, 0x00, 0x00},  // U+2511 ┑
+  {0x04, 0x3C, 0x3C, 0x00},  // U+2512 ┒
+  {0x0C, 0x3C, 0x3C, 0x00},  // U+2513 ┓
+  {0x00, 0x07, 0x04, 0x04},  // U+2514 └
+  {0x00, 0x0F, 0x0C, 0x0C},  // U+2515 ┕
+  {0x00, 0x07, 0x07, 0x04},  // U+2516 ┖
+  {0x00, 0x0F, 0x0F, 0x0C},  // U+2517 ┗
+  {0x04, 0x07, 0x00, 0x00},  // U+2518 ┘
+  {0x0C, 0x0F, 0x00, 0x00},  // U+2519 ┙
+  {0x04, 0x07, 0x07, 0x00},  // U+251A ┚
+  {0x0C, 0x0F, 0x0F, 0x00},  // U+251B ┛
+  {0x00, 0x3F, 0x04, 0x04},  // U+251C ├
+  {0x00, 0x3F, 0x0C, 0x0C},  // U+251D ┝
+  {0x00, 0x3F, 0x07, 0x04},  // U+251E ┞
+  {0x00, 0x3F, 0x3C, 0x04},  // U+251F ┟
+  {0x00, 0x3F, 0x3F, 0x04},  // U+2520 ┠
+  {0x00, 0x3F, 0x0F, 0x0C},  // U+2521 ┡
+  {0x00, 0x3F, 0x3C, 0x0C},  // U+2522 ┢
+  {0x00, 0x3F, 0x3F, 0x0C},  // U+2523 ┣
+  {0x04, 0x3F, 0x00, 0x00},  // U+2524 ┤
+  {0x0C, 0x3F, 0x00, 0x00},  // U+2525 ┥
+  {0x04, 0x3F, 0x07, 0x00},  // U+2526 ┦
+  {0x04, 0x3F, 0x3C, 0x00},  // U+2527 ┧
+  {0x04, 0x3F, 0x3F, 0x00},  // U+2528 ┨
+  {0x0C, 0x3F, 0x0F, 0x00},  // U+2529 ┩
+  {0x0C, 0x3F, 0x3C, 0x00},  // U+252A ┪
+  {0x0C, 0x3F, 0x3F, 0x00},  // U+252B ┫
+  {0x04, 0x3C, 0x04, 0x04},  // U+252C ┬
+  {0x0C, 0x3C, 0x04, 0x04},  // U+252D ┭
+  {0x04, 0x3C, 0x0C, 0x0C},  // U+252E ┮
+  {0x0C, 0x3C, 0x0C, 0x0C},  // U+252F ┯
+  {0x04, 0x3C, 0x3C, 0x04},  // U+2530 ┰
+  {0x0C, 0x3C, 0x3C, 0x04},  // U+2531 ┱
+  {0x04, 0x3C, 0x3C, 0x0C},  // U+2532 ┲
+  {0x0C, 0x3C, 0x3C, 0x0C},  // U+2533 ┳
+  {0x04, 0x07, 0x04, 0x04},  // U+2534 ┴
+  {0x0C, 0x0F, 0x04, 0x04},  // U+2535 ┵
+  {0x04, 0x0F, 0x0C, 0x0C},  // U+2536 ┶
+  {0x0C, 0x0F, 0x0C, 0x0C},  // U+2537 ┷
+  {0x04, 0x07, 0x07, 0x04},  // U+2538 ┸
+  {0x0C, 0x0F, 0x0F, 0x04},  // U+2539 ┹
+  {0x04, 0x0F, 0x0F, 0x0C},  // U+253A ┺
+  {0x0C, 0x0F, 0x0F, 0x0C},  // U+253B ┻
+  {0x04, 0x3F, 0x04, 0x04},  // U+253C ┼
+  {0x0C, 0x3F, 0x04, 0x04},  // U+253D ┽
+  {0x04, 0x3F, 0x0C, 0x0C},  // U+253E ┾
+  {0x0C, 0x3F, 0x0C, 0x0C},  // U+253F ┿
+  {0x04, 0x3F, 0x07, 0x04},  // U+2540 ╀
+  {0x04, 0x3F, 0x3C, 0x04},  // U+2541 ╁
+  {0x04, 0x3F, 0x3F, 0x04},  // U+2542 ╂
+  {0x0C, 0x3F, 0x0F, 0x04},  // U+2543 ╃
+  {0x04, 0x3F, 0x0F, 0x0C},  // U+2544 ╄
+  {0x0C, 0x3F, 0x3C, 0x04},  // U+2545 ╅
+  {0x04, 0x3F, 0x3C, 0x0C},  // U+2546 ╆
+  {0x0C, 0x3F, 0x0F, 0x0C},  // U+2547 ╇
+  {0x0C, 0x3F, 0x3C, 0x0C},  // U+2548 ╈
+  {0x0C, 0x3F, 0x3F, 0x04},  // U+2549 ╉
+  {0x04, 0x3F, 0x3F, 0x0C},  // U+254A ╊
+  {0x0C, 0x3F, 0x3F, 0x0C},  // U+254B ╋
+  {0x04, 0x00, 0x04, 0x00},  // U+254C ╌
+  {0x0C, 0x00, 0x0C, 0x00},  // U+254D ╍
+  {0x00, 0x1B, 0x00, 0x00},  // U+254E ╎
+  {0x00, 0x1B, 0x1B, 0x00},  // U+254F ╏
+  {0x0A, 0x0A, 0x0A, 0x0A},  // U+2550 ═
+  {0x3F, 0x00, 0x3F, 0x00},  // U+2551 ║
+  {0x00, 0x3E, 0x0A, 0x0A},  // U+2552 ╒
+  {0x3C, 0x04, 0x3C, 0x04},  // U+2553 ╓
+  {0x3E, 0x02, 0x3A, 0x0A},  // U+2554 ╔
+  {0x0A, 0x3E, 0x00, 0x00},  // U+2555 ╕
+  {0x3C, 0x04, 0x3C, 0x00},  // U+2556 ╖
+  {0x3A, 0x02, 0x3E, 0x00},  // U+2557 ╗
+  {0x00, 0x0F, 0x0A, 0x0A},  // U+2558 ╘
+  {0x07, 0x04, 0x07, 0x04},  // U+2559 ╙
+  {0x0F, 0x08, 0x0B, 0x0A},  // U+255A ╚
+  {0x0A, 0x0F, 0x00, 0x00},  // U+255B ╛
+  {0x07, 0x04, 0x07, 0x00},  // U+255C ╜
+  {0x0B, 0x08, 0x0F, 0x00},  // U+255D ╝
+  {0x00, 0x3F, 0x0A, 0x0A},  // U+255E ╞
+  {0x3F, 0x00, 0x3F, 0x04},  // U+255F ╟
+  {0x3F, 0x00, 0x3B, 0x0A},  // U+2560 ╠
+  {0x0A, 0x3F, 0x00, 0x00},  // U+2561 ╡
+  {0x3F, 0x00, 0x3F, 0x00},  // U+2562 ╢
+  {0x3B, 0x00, 0x3F, 0x00},  // U+2563 ╣
+  {0x0A, 0x3A, 0x0A, 0x0A},  // U+2564 ╤
+  {0x3C, 0x04, 0x3C, 0x04},  // U+2565 ╥
+  {0x3A, 0x02, 0x3A, 0x0A},  // U+2566 ╦
+  {0x0A, 0x0B, 0x0A, 0x0A},  // U+2567 ╧
+  {0x07, 0x04, 0x07, 0x04},  // U+2568 ╨
+  {0x0B, 0x08, 0x0B, 0x0A},  // U+2569 ╩
+  {0x0A, 0x3B, 0x0A, 0x0A},  // U+256A ╪
+  {0x3F, 0x00, 0x3F, 0x04},  // U+256B ╫
+  {0x3B, 0x00, 0x3B, 0x0A},  // U+256C ╬
+  {0x00, 0x38, 0x04, 0x04},  // U+256D ╭
+  {0x04, 0x38, 0x00, 0x00},  // U+256E ╮
+  {0x04, 0x03, 0x00, 0x00},  // U+256F ╯
+  {0x00, 0x03, 0x04, 0x04},  // U+2570 ╰
+  {0x20, 0x18, 0x04, 0x03},  // U+2571 ╱
+  {0x03, 0x04, 0x18, 0x20},  // U+2572 ╲
+  {0x23, 0x1C, 0x1C, 0x23},  // U+2573 ╳
+  {0x04, 0x04, 0x00, 0x00},  // U+2574 ╴
+  {0x00, 0x07, 0x00, 0x00},  // U+2575 ╵
+  {0x00, 0x04, 0x04, 0x04},  // U+2576 ╶
+  {0x00, 0x3C, 0x00, 0x00},  // U+2577 ╷
+  {0x0C, 0x0C, 0x00, 0x00},  // U+2578 ╸
+  {0x00, 0x07, 0x07, 0x00},  // U+2579 ╹
+  {0x00, 0x0C, 0x0C, 0x0C},  // U+257A ╺
+  {0x00, 0x3C, 0x3C, 0x00},  // U+257B ╻
+  {0x04, 0x0C, 0x0C, 0x0C},  // U+257C ╼
+  {0x00, 0x3F, 0x3C, 0x00},  // U+257D ╽
+  {0x0C, 0x0C, 0x04, 0x04},  // U+257E ╾
+  {0x00, 0x3F, 0x07, 0x00},  // U+257F ╿
+  {0x07, 0x07, 0x07, 0x07},  // U+2580 ▀
+  {0x20, 0x20, 0x20, 0x20},  // U+2581 ▁
+  {0x30, 0x30, 0x30, 0x30},  // U+2582 ▂
+  {0x30, 0x30, 0x30, 0x30},  // U+2583 ▃
+  {0x38, 0x38, 0x38, 0x38},  // U+2584 ▄
+  {0x3C, 0x3C, 0x3C, 0x3C},  // U+2585 ▅
+  {0x3E, 0x3E, 0x3E, 0x3E},  // U+2586 ▆
+  {0x3E, 0x3E, 0x3E, 0x3E},  // U+2587 ▇
+  {0x3F, 0x3F, 0x3F, 0x3F},  // U+2588 █
+  {0x3F, 0x3F, 0x3F, 0x3F},  // U+2589 ▉
+  {0x3F, 0x3F, 0x3F, 0x00},  // U+258A ▊
+  {0x3F, 0x3F, 0x3F, 0x00},  // U+258B ▋
+  {0x3F, 0x3F, 0x00, 0x00},  // U+258C ▌
+  {0x3F, 0x3F, 0x00, 0x00},  // U+258D ▍
+  {0x3F, 0x00, 0x00, 0x00},  // U+258E ▎
+  {0x3F, 0x00, 0x00, 0x00},  // U+258F ▏
+  {0x00, 0x00, 0x3F, 0x3F},  // U+2590 ▐
+  {0x15, 0x00, 0x15, 0x00},  // U+2591 ░
+  {0x15, 0x2A, 0x15, 0x2A},  // U+2592 ▒
+  {0x3F, 0x15, 0x3F, 0x15},  // U+2593 ▓
+  {0x01, 0x01, 0x01, 0x01},  // U+2594 ▔
+  {0x00, 0x00, 0x00, 0x3F},  // U+2595 ▕
+  {0x38, 0x38, 0x00, 0x00},  // U+2596 ▖
+  {0x00, 0x00, 0x38, 0x38},  // U+2597 ▗
+  {0x07, 0x07, 0x00, 0x00},  // U+2598 ▘
+  {0x3F, 0x3F, 0x38, 0x38},  // U+2599 ▙
+  {0x07, 0x07, 0x38, 0x38},  // U+259A ▚
+  {0x3F, 0x3F, 0x07, 0x07},  // U+259B ▛
+  {0x07, 0x07, 0x3F, 0x3F},  // U+259C ▜
+  {0x00, 0x00, 0x07, 0x07},  // U+259D ▝
+  {0x38, 0x38, 0x07, 0x07},  // U+259E ▞
+  {0x38, 0x38, 0x3F, 0x3F},  // U+259F ▟
+};
+
+// Cell fonts, in the order of FONTS in tools/glyphgen.py
+struct GlyphFont {
+  uint8_t width;           // Cell size in pixels
+  uint8_t height;
+  const uint8_t* columns;  // width column bytes per font index
+};
+
+static const GlyphFont glyphFonts[GLYPH_FONT_COUNT] = {
+  {6, 8, &glyphAtlas6x8[0][0]},
+  {4, 6, &glyphAtlas4x6[0][0]},
+};
+
+#endif
@@ -0,0 +1,822 @@
+/*
+ * glyphshapes.h - Box drawing and block element shapes
+ *
+ * Generated by tools/glyphgen.py, do not edit.
+ * Included by renderer.cpp only.
+ */
+
+#ifndef GLYPHSHAPES_H
+#define GLYPHSHAPES_H
+
+#include <Arduino.h>
+
+// Font indices of U+2500-U+259F
+#define GLYPH_SHAPE_FIRST 322
+#define GLYPH_SHAPE_COUNT 160
+
+// Filled rectangle in cell pixels. pattern is a 2x2 mask, bit
+// (y & 1) * 2 + (x & 1), 0xF for solid and less for shades
+struct GlyphRect {
+  uint8_t x;
+  uint8_t y;
+  uint8_t w;
+  uint8_t h;
+  uint8_t pattern;
+};
+
+// 6x8 cells. Rectangles of shape n: glyphShapeRects6x8[glyphShapeStart6x8[n]]
+// up to glyphShapeRects6x8[glyphShapeStart6x8[n + 1]]
+static const uint16_t glyphShapeStart6x8[GLYPH_SHAPE_COUNT + 1] = {
+  0, 1, 2, 3, 4, 7, 10, 13, 16, 19, 22, 26, 30, 32, 34, 36,
+  38, 40, 42, 44, 46, 48, 50, 52, 54, 56, 58, 60, 62, 64, 66, 69,
+  72, 74, 77, 80, 82, 84, 86, 89, 92, 94, 97, 100, 102, 104, 107, 110,
+  112, 114, 117, 120, 122, 124, 127, 130, 132, 134, 137, 140, 142, 144, 147, 150,
+  152, 155, 158, 160, 164, 168, 172, 176, 179, 182, 185, 188, 190, 192, 194, 196,
+  198, 200, 202, 205, 208, 212, 215, 218, 222, 225, 228, 232, 235, 238, 242, 245,
+  248, 253, 256, 259, 264, 267, 270, 275, 278, 281, 286, 290, 294, 302, 304, 306,
+  308, 310, 316, 322, 331, 332, 333, 334, 335, 336, 337, 338, 339, 341, 343, 345,
+  347, 348, 349, 350, 351, 352, 353, 354, 355, 356, 357, 358, 359, 360, 361, 362,
+  363, 364, 365, 366, 367, 368, 369, 370, 371, 372, 374, 376, 378, 380, 381, 383,
+  385,
+};
+
+static const GlyphRect glyphShapeRects6x8[385] = {
+  {0, 3, 6, 1, 0xF},  // U+2500 ─
+  {0, 3, 6, 2, 0xF},  // U+2501 ━
+  {2, 0, 1, 8, 0xF},  // U+2502 │
+  {2, 0, 2, 8, 0xF},  // U+2503 ┃
+  {0, 3, 1, 1, 0xF},  // U+2504 ┄
+  {2, 3, 1, 1, 0xF},
+  {4, 3, 1, 1, 0xF},
+  {0, 3, 1, 2, 0xF},  // U+2505 ┅
+  {2, 3, 1, 2, 0xF},
+  {4, 3, 1, 2, 0xF},
+  {2, 0, 1, 2, 0xF},  // U+2506 ┆
+  {2, 3, 1, 2, 0xF},
+  {2, 6, 1, 1, 0xF},
+  {2, 0, 2, 2, 0xF},  // U+2507 ┇
+  {2, 3, 2, 2, 0xF},
+  {2, 6, 2, 1, 0xF},
+  {0, 3, 1, 1, 0xF},  // U+2508 ┈
+  {2, 3, 1, 1, 0xF},
+  {4, 3, 1, 1, 0xF},
+  {0, 3, 1, 2, 0xF},  // U+2509 ┉
+  {2, 3, 1, 2, 0xF},
+  {4, 3, 1, 2, 0xF},
+  {2, 0, 1, 1, 0xF},  // U+250A ┊
+  {2, 2, 1, 1, 0xF},
+  {2, 4, 1, 1, 0xF},
+  {2, 6, 1, 1, 0xF},
+  {2, 0, 2, 1, 0xF},  // U+250B ┋
+  {2, 2, 2, 1, 0xF},
+  {2, 4, 2, 1, 0xF},
+  {2, 6, 2, 1, 0xF},
+  {2, 3, 1, 5, 0xF},  // U+250C ┌
+  {3, 3, 3, 1, 0xF},
+  {2, 3, 4, 2, 0xF},  // U+250D ┍
+  {2, 5, 1, 3, 0xF},
+  {2, 3, 2, 5, 0xF},  // U+250E ┎
+  {4, 3, 2, 1, 0xF},
+  {2, 3, 2, 5, 0xF},  // U+250F ┏
+  {4, 3, 2, 2, 0xF},
+  {0, 3, 3, 1, 0xF},  // U+2510 ┐
+  {2, 4, 1, 4, 0xF},
+  {0, 3, 3, 2, 0xF},  // U+2511 ┑
+  {2, 5, 1, 3, 0xF},
+  {0, 3, 4, 1, 0xF},  // U+2512 ┒
+  {2, 4, 2, 4, 0xF},
+  {0, 3, 4, 2, 0xF},  // U+2513 ┓
+  {2, 5, 2, 3, 0xF},
+  {2, 0, 1, 4, 0xF},  // U+2514 └
+  {3, 3, 3, 1, 0xF},
+  {2, 0, 1, 5, 0xF},  // U+2515 ┕
+  {3, 3, 3, 2, 0xF},
+  {2, 0, 2, 4, 0xF},  // U+2516 ┖
+  {4, 3, 2, 1, 0xF},
+  {2, 0, 2, 5, 0xF},  // U+2517 ┗
+  {4, 3, 2, 2, 0xF},
+  {2, 0, 1, 4, 0xF},  // U+2518 ┘
+  {0, 3, 3, 1, 0xF},
+  {2, 0, 1, 5, 0xF},  // U+2519 ┙
+  {0, 3, 3, 2, 0xF},
+  {2, 0, 2, 4, 0xF},  // U+251A ┚
+  {0, 3, 4, 1, 0xF},
+  {2, 0, 2, 5, 0xF},  // U+251B ┛
+  {0, 3, 4, 2, 0xF},
+  {2, 0, 1, 8, 0xF},  // U+251C ├
+  {3, 3, 3, 1, 0xF},
+  {2, 0, 1, 8, 0xF},  // U+251D ┝
+  {3, 3, 3, 2, 0xF},
+  {2, 0, 2, 4, 0xF},  // U+251E ┞
+  {4, 3, 2, 1, 0xF},
+  {2, 4, 1, 4, 0xF},
+  {2, 0, 1, 8, 0xF},  // U+251F ┟
+  {3, 3, 1, 5, 0xF},
+  {4, 3, 2, 1, 0xF},
+  {2, 0, 2, 8, 0xF},  // U+2520 ┠
+  {4, 3, 2, 1, 0xF},
+  {2, 0, 2, 5, 0xF},  // U+2521 ┡
+  {4, 3, 2, 2, 0xF},
+  {2, 5, 1, 3, 0xF},
+  {2, 0, 1, 8, 0xF},  // U+2522 ┢
+  {3, 3, 3, 2, 0xF},
+  {3, 5, 1, 3, 0xF},
+  {2, 0, 2, 8, 0xF},  // U+2523 ┣
+  {4, 3, 2, 2, 0xF},
+  {2, 0, 1, 8, 0xF},  // U+2524 ┤
+  {0, 3, 3, 1, 0xF},
+  {2, 0, 1, 8, 0xF},  // U+2525 ┥
+  {0, 3, 3, 2, 0xF},
+  {2, 0, 2, 4, 0xF},  // U+2526 ┦
+  {0, 3, 4, 1, 0xF},
+  {2, 4, 1, 4, 0xF},
+  {2, 0, 1, 8, 0xF},  // U+2527 ┧
+  {0, 3, 4, 1, 0xF},
+  {3, 4, 1, 4, 0xF},
+  {2, 0, 2, 8, 0xF},  // U+2528 ┨
+  {0, 3, 4, 1, 0xF},
+  {2, 0, 2, 5, 0xF},  // U+2529 ┩
+  {0, 3, 4, 2, 0xF},
+  {2, 5, 1, 3, 0xF},
+  {2, 0, 1, 8, 0xF},  // U+252A ┪
+  {0, 3, 4, 2, 0xF},
+  {3, 5, 1, 3, 0xF},
+  {2, 0, 2, 8, 0xF},  // U+252B ┫
+  {0, 3, 4, 2, 0xF},
+  {0, 3, 6, 1, 0xF},  // U+252C ┬
+  {2, 4, 1, 4, 0xF},
+  {0, 3, 6, 1, 0xF},  // U+252D ┭
+  {0, 4, 3, 1, 0xF},
+  {2, 5, 1, 3, 0xF},
+  {0, 3, 6, 1, 0xF},  // U+252E ┮
+  {2, 4, 4, 1, 0xF},
+  {2, 5, 1, 3, 0xF},
+  {0, 3, 6, 2, 0xF},  // U+252F ┯
+  {2, 5, 1, 3, 0xF},
+  {0, 3, 6, 1, 0xF},  // U+2530 ┰
+  {2, 4, 2, 4, 0xF},
+  {0, 3, 4, 2, 0xF},  // U+2531 ┱
+  {4, 3, 2, 1, 0xF},
+  {2, 5, 2, 3, 0xF},
+  {0, 3, 6, 1, 0xF},  // U+2532 ┲
+  {2, 4, 2, 4, 0xF},
+  {4, 4, 2, 1, 0xF},
+  {0, 3, 6, 2, 0xF},  // U+2533 ┳
+  {2, 5, 2, 3, 0xF},
+  {2, 0, 1, 4, 0xF},  // U+2534 ┴
+  {0, 3, 6, 1, 0xF},
+  {2, 0, 1, 5, 0xF},  // U+2535 ┵
+  {0, 3, 6, 1, 0xF},
+  {0, 4, 3, 1, 0xF},
+  {2, 0, 1, 5, 0xF},  // U+2536 ┶
+  {0, 3, 6, 1, 0xF},
+  {3, 4, 3, 1, 0xF},
+  {2, 0, 1, 5, 0xF},  // U+2537 ┷
+  {0, 3, 6, 2, 0xF},
+  {2, 0, 2, 4, 0xF},  // U+2538 ┸
+  {0, 3, 6, 1, 0xF},
+  {2, 0, 2, 5, 0xF},  // U+2539 ┹
+  {0, 3, 6, 1, 0xF},
+  {0, 4, 4, 1, 0xF},
+  {2, 0, 2, 5, 0xF},  // U+253A ┺
+  {0, 3, 6, 1, 0xF},
+  {4, 4, 2, 1, 0xF},
+  {2, 0, 2, 5, 0xF},  // U+253B ┻
+  {0, 3, 6, 2, 0xF},
+  {2, 0, 1, 8, 0xF},  // U+253C ┼
+  {0, 3, 6, 1, 0xF},
+  {2, 0, 1, 8, 0xF},  // U+253D ┽
+  {0, 3, 6, 1, 0xF},
+  {0, 4, 3, 1, 0xF},
+  {2, 0, 1, 8, 0xF},  // U+253E ┾
+  {0, 3, 6, 1, 0xF},
+  {3, 4, 3, 1, 0xF},
+  {2, 0, 1, 8, 0xF},  // U+253F ┿
+  {0, 3, 6, 2, 0xF},
+  {2, 0, 2, 4, 0xF},  // U+2540 ╀
+  {0, 3, 6, 1, 0xF},
+  {2, 4, 1, 4, 0xF},
+  {2, 0, 1, 8, 0xF},  // U+2541 ╁
+  {0, 3, 6, 1, 0xF},
+  {3, 4, 1, 4, 0xF},
+  {2, 0, 2, 8, 0xF},  // U+2542 ╂
+  {0, 3, 6, 1, 0xF},
+  {2, 0, 2, 5, 0xF},  // U+2543 ╃
+  {0, 3, 6, 1, 0xF},
+  {0, 4, 4, 1, 0xF},
+  {2, 5, 1, 3, 0xF},
+  {2, 0, 2, 5, 0xF},  // U+2544 ╄
+  {0, 3, 6, 1, 0xF},
+  {4, 4, 2, 1, 0xF},
+  {2, 5, 1, 3, 0xF},
+  {2, 0, 1, 8, 0xF},  // U+2545 ╅
+  {0, 3, 4, 2, 0xF},
+  {4, 3, 2, 1, 0xF},
+  {3, 5, 1, 3, 0xF},
+  {2, 0, 1, 8, 0xF},  // U+2546 ╆
+  {0, 3, 6, 1, 0xF},
+  {3, 4, 1, 4, 0xF},
+  {4, 4, 2, 1, 0xF},
+  {2, 0, 2, 5, 0xF},  // U+2547 ╇
+  {0, 3, 6, 2, 0xF},
+  {2, 5, 1, 3, 0xF},
+  {2, 0, 1, 8, 0xF},  // U+2548 ╈
+  {0, 3, 6, 2, 0xF},
+  {3, 5, 1, 3, 0xF},
+  {2, 0, 2, 8, 0xF},  // U+2549 ╉
+  {0, 3, 6, 1, 0xF},
+  {0, 4, 4, 1, 0xF},
+  {2, 0, 2, 8, 0xF},  // U+254A ╊
+  {0, 3, 6, 1, 0xF},
+  {4, 4, 2, 1, 0xF},
+  {2, 0, 2, 8, 0xF},  // U+254B ╋
+  {0, 3, 6, 2, 0xF},
+  {0, 3, 2, 1, 0xF},  // U+254C ╌
+  {3, 3, 2, 1, 0xF},
+  {0, 3, 2, 2, 0xF},  // U+254D ╍
+  {3, 3, 2, 2, 0xF},
+  {2, 0, 1, 3, 0xF},  // U+254E ╎
+  {2, 4, 1, 3, 0xF},
+  {2, 0, 2, 3, 0xF},  // U+254F ╏
+  {2, 4, 2, 3, 0xF},
+  {0, 2, 6, 1, 0xF},  // U+2550 ═
+  {0, 4, 6, 1, 0xF},
+  {1, 0, 1, 8, 0xF},  // U+2551 ║
+  {3, 0, 1, 8, 0xF},
+  {2, 2, 1, 6, 0xF},  // U+2552 ╒
+  {3, 2, 3, 1, 0xF},
+  {3, 4, 3, 1, 0xF},
+  {1, 3, 5, 1, 0xF},  // U+2553 ╓
+  {1, 4, 1, 4, 0xF},
+  {3, 4, 1, 4, 0xF},
+  {1, 2, 1, 6, 0xF},  // U+2554 ╔
+  {2, 2, 4, 1, 0xF},
+  {3, 4, 1, 4, 0xF},
+  {4, 4, 2, 1, 0xF},
+  {0, 2, 3, 1, 0xF},  // U+2555 ╕
+  {2, 3, 1, 5, 0xF},
+  {0, 4, 3, 1, 0xF},
+  {0, 3, 4, 1, 0xF},  // U+2556 ╖
+  {1, 4, 1, 4, 0xF},
+  {3, 4, 1, 4, 0xF},
+  {0, 2, 4, 1, 0xF},  // U+2557 ╗
+  {3, 3, 1, 5, 0xF},
+  {0, 4, 2, 1, 0xF},
+  {1, 5, 1, 3, 0xF},
+  {2, 0, 1, 5, 0xF},  // U+2558 ╘
+  {3, 2, 3, 1, 0xF},
+  {3, 4, 3, 1, 0xF},
+  {1, 0, 1, 4, 0xF},  // U+2559 ╙
+  {3, 0, 1, 4, 0xF},
+  {2, 3, 4, 1, 0xF},
+  {1, 0, 1, 5, 0xF},  // U+255A ╚
+  {3, 0, 1, 3, 0xF},
+  {4, 2, 2, 1, 0xF},
+  {2, 4, 4, 1, 0xF},
+  {2, 0, 1, 5, 0xF},  // U+255B ╛
+  {0, 2, 3, 1, 0xF},
+  {0, 4, 3, 1, 0xF},
+  {1, 0, 1, 4, 0xF},  // U+255C ╜
+  {3, 0, 1, 4, 0xF},
+  {0, 3, 4, 1, 0xF},
+  {1, 0, 1, 3, 0xF},  // U+255D ╝
+  {3, 0, 1, 5, 0xF},
+  {0, 2, 2, 1, 0xF},
+  {0, 4, 4, 1, 0xF},
+  {2, 0, 1, 8, 0xF},  // U+255E ╞
+  {3, 2, 3, 1, 0xF},
+  {3, 4, 3, 1, 0xF},
+  {1, 0, 1, 8, 0xF},  // U+255F ╟
+  {3, 0, 1, 8, 0xF},
+  {4, 3, 2, 1, 0xF},
+  {1, 0, 1, 8, 0xF},  // U+2560 ╠
+  {3, 0, 1, 3, 0xF},
+  {4, 2, 2, 1, 0xF},
+  {3, 4, 1, 4, 0xF},
+  {4, 4, 2, 1, 0xF},
+  {2, 0, 1, 8, 0xF},  // U+2561 ╡
+  {0, 2, 3, 1, 0xF},
+  {0, 4, 3, 1, 0xF},
+  {1, 0, 1, 8, 0xF},  // U+2562 ╢
+  {3, 0, 1, 8, 0xF},
+  {0, 3, 2, 1, 0xF},
+  {1, 0, 1, 3, 0xF},  // U+2563 ╣
+  {3, 0, 1, 8, 0xF},
+  {0, 2, 2, 1, 0xF},
+  {0, 4, 2, 1, 0xF},
+  {1, 5, 1, 3, 0xF},
+  {0, 2, 6, 1, 0xF},  // U+2564 ╤
+  {0, 4, 6, 1, 0xF},
+  {2, 5, 1, 3, 0xF},
+  {0, 3, 6, 1, 0xF},  // U+2565 ╥
+  {1, 4, 1, 4, 0xF},
+  {3, 4, 1, 4, 0xF},
+  {0, 2, 6, 1, 0xF},  // U+2566 ╦
+  {0, 4, 2, 1, 0xF},
+  {3, 4, 1, 4, 0xF},
+  {4, 4, 2, 1, 0xF},
+  {1, 5, 1, 3, 0xF},
+  {2, 0, 1, 3, 0xF},  // U+2567 ╧
+  {0, 2, 6, 1, 0xF},
+  {0, 4, 6, 1, 0xF},
+  {1, 0, 1, 4, 0xF},  // U+2568 ╨
+  {3, 0, 1, 4, 0xF},
+  {0, 3, 6, 1, 0xF},
+  {1, 0, 1, 3, 0xF},  // U+2569 ╩
+  {3, 0, 1, 3, 0xF},
+  {0, 2, 2, 1, 0xF},
+  {4, 2, 2, 1, 0xF},
+  {0, 4, 6, 1, 0xF},
+  {2, 0, 1, 3, 0xF},  // U+256A ╪
+  {0, 2, 6, 1, 0xF},
+  {0, 4, 6, 1, 0xF},
+  {2, 5, 1, 3, 0xF},
+  {1, 0, 1, 8, 0xF},  // U+256B ╫
+  {3, 0, 1, 8, 0xF},
+  {0, 3, 2, 1, 0xF},
+  {4, 3, 2, 1, 0xF},
+  {1, 0, 1, 3, 0xF},  // U+256C ╬
+  {3, 0, 1, 3, 0xF},
+  {0, 2, 2, 1, 0xF},
+  {4, 2, 2, 1, 0xF},
+  {0, 4, 2, 1, 0xF},
+  {3, 4, 1, 4, 0xF},
+  {4, 4, 2, 1, 0xF},
+  {1, 5, 1, 3, 0xF},
+  {3, 3, 3, 1, 0xF},  // U+256D ╭
+  {2, 4, 1, 4, 0xF},
+  {0, 3, 2, 1, 0xF},  // U+256E ╮
+  {2, 4, 1, 4, 0xF},
+  {2, 0, 1, 3, 0xF},  // U+256F ╯
+  {0, 3, 2, 1, 0xF},
+  {2, 0, 1, 3, 0xF},  // U+2570 ╰
+  {3, 3, 3, 1, 0xF},
+  {5, 0, 1, 2, 0xF},  // U+2571 ╱
+  {4, 2, 1, 1, 0xF},
+  {3, 3, 1, 1, 0xF},
+  {2, 4, 1, 2, 0xF},
+  {1, 6, 1, 1, 0xF},
+  {0, 7, 1, 1, 0xF},
+  {0, 0, 1, 2, 0xF},  // U+2572 ╲
+  {1, 2, 1, 1, 0xF},
+  {2, 3, 1, 1, 0xF},
+  {3, 4, 1, 2, 0xF},
+  {4, 6, 1, 1, 0xF},
+  {5, 7, 1, 1, 0xF},
+  {0, 0, 1, 2, 0xF},  // U+2573 ╳
+  {5, 0, 1, 2, 0xF},
+  {1, 2, 1, 1, 0xF},
+  {4, 2, 1, 1, 0xF},
+  {2, 3, 2, 3, 0xF},
+  {1, 6, 1, 1, 0xF},
+  {4, 6, 1, 1, 0xF},
+  {0, 7, 1, 1, 0xF},
+  {5, 7, 1, 1, 0xF},
+  {0, 3, 3, 1, 0xF},  // U+2574 ╴
+  {2, 0, 1, 4, 0xF},  // U+2575 ╵
+  {2, 3, 4, 1, 0xF},  // U+2576 ╶
+  {2, 3, 1, 5, 0xF},  // U+2577 ╷
+  {0, 3, 3, 2, 0xF},  // U+2578 ╸
+  {2, 0, 2, 4, 0xF},  // U+2579 ╹
+  {2, 3, 4, 2, 0xF},  // U+257A ╺
+  {2, 3, 2, 5, 0xF},  // U+257B ╻
+  {0, 3, 6, 1, 0xF},  // U+257C ╼
+  {2, 4, 4, 1, 0xF},
+  {2, 0, 1, 8, 0xF},  // U+257D ╽
+  {3, 3, 1, 5, 0xF},
+  {0, 3, 6, 1, 0xF},  // U+257E ╾
+  {0, 4, 3, 1, 0xF},
+  {2, 0, 2, 4, 0xF},  // U+257F ╿
+  {2, 4, 1, 4, 0xF},
+  {0, 0, 6, 4, 0xF},  // U+2580 ▀
+  {0, 7, 6, 1, 0xF},  // U+2581 ▁
+  {0, 6, 6, 2, 0xF},  // U+2582 ▂
+  {0, 5, 6, 3, 0xF},  // U+2583 ▃
+  {0, 4, 6, 4, 0xF},  // U+2584 ▄
+  {0, 3, 6, 5, 0xF},  // U+2585 ▅
+  {0, 2, 6, 6, 0xF},  // U+2586 ▆
+  {0, 1, 6, 7, 0xF},  // U+2587 ▇
+  {0, 0, 6, 8, 0xF},  // U+2588 █
+  {0, 0, 5, 8, 0xF},  // U+2589 ▉
+  {0, 0, 5, 8, 0xF},  // U+258A ▊
+  {0, 0, 4, 8, 0xF},  // U+258B ▋
+  {0, 0, 3, 8, 0xF},  // U+258C ▌
+  {0, 0, 2, 8, 0xF},  // U+258D ▍
+  {0, 0, 2, 8, 0xF},  // U+258E ▎
+  {0, 0, 1, 8, 0xF},  // U+258F ▏
+  {3, 0, 3, 8, 0xF},  // U+2590 ▐
+  {0, 0, 6, 8, 0x1},  // U+2591 ░
+  {0, 0, 6, 8, 0x9},  // U+2592 ▒
+  {0, 0, 6, 8, 0x7},  // U+2593 ▓
+  {0, 0, 6, 1, 0xF},  // U+2594 ▔
+  {5, 0, 1, 8, 0xF},  // U+2595 ▕
+  {0, 4, 3, 4, 0xF},  // U+2596 ▖
+  {3, 4, 3, 4, 0xF},  // U+2597 ▗
+  {0, 0, 3, 4, 0xF},  // U+2598 ▘
+  {0, 0, 3, 8, 0xF},  // U+2599 ▙
+  {3, 4, 3, 4, 0xF},
+  {0, 0, 3, 4, 0xF},  // U+259A ▚
+  {3, 4, 3, 4, 0xF},
+  {0, 0, 6, 4, 0xF},  // U+259B ▛
+  {0, 4, 3, 4, 0xF},
+  {0, 0, 6, 4, 0xF},  // U+259C ▜
+  {3, 4, 3, 4, 0xF},
+  {3, 0, 3, 4, 0xF},  // U+259D ▝
+  {3, 0, 3, 4, 0xF},  // U+259E ▞
+  {0, 4, 3, 4, 0xF},
+  {3, 0, 3, 8, 0xF},  // U+259F ▟
+  {0, 4, 6, 4, 0xF},
+};
+
+// 4x6 cells. Rectangles of shape n: glyphShapeRects4x6[glyphShapeStart4x6[n]]
+// up to glyphShapeRects4x6[glyphShapeStart4x6[n + 1]]
+static const uint16_t glyphShapeStart4x6[GLYPH_SHAPE_COUNT + 1] = {
+  0, 1, 2, 3, 4, 6, 8, 11, 14, 16, 18, 21, 24, 26, 28, 30,
+  32, 34, 36, 38, 40, 42, 44, 46, 48, 50, 52, 54, 56, 58, 60, 63,
+  66, 68, 71, 74, 76, 78, 80, 83, 86, 88, 91, 94, 96, 98, 101, 104,
+  106, 108, 111, 114, 116, 118, 121, 124, 126, 128, 131, 134, 136, 138, 141, 144,
+  146, 149, 152, 154, 158, 162, 166, 170, 173, 176, 179, 182, 184, 186, 188, 190,
+  192, 194, 196, 199, 202, 206, 209, 212, 215, 218, 221, 225, 228, 231, 234, 237,
+  240, 245, 248, 250, 253, 256, 259, 263, 266, 269, 273, 277, 280, 286, 288, 290,
+  292, 294, 298, 302, 307, 308, 309, 310, 311, 312, 313, 314, 315, 317, 319, 321,
+  323, 324, 325, 326, 327, 328, 329, 330, 331, 332, 333, 334, 335, 336, 337, 338,
+  339, 340, 341, 342, 343, 344, 345, 346, 347, 348, 350, 352, 354, 356, 357, 359,
+  361,
+};
+
+static const GlyphRect glyphShapeRects4x6[361] = {
+  {0, 2, 4, 1, 0xF},  // U+2500 ─
+  {0, 2, 4, 2, 0xF},  // U+2501 ━
+  {1, 0, 1, 6, 0xF},  // U+2502 │
+  {1, 0, 2, 6, 0xF},  // U+2503 ┃
+  {0, 2, 1, 1, 0xF},  // U+2504 ┄
+  {2, 2, 1, 1, 0xF},
+  {0, 2, 1, 2, 0xF},  // U+2505 ┅
+  {2, 2, 1, 2, 0xF},
+  {1, 0, 1, 1, 0xF},  // U+2506 ┆
+  {1, 2, 1, 1, 0xF},
+  {1, 4, 1, 1, 0xF},
+  {1, 0, 2, 1, 0xF},  // U+2507 ┇
+  {1, 2, 2, 1, 0xF},
+  {1, 4, 2, 1, 0xF},
+  {0, 2, 1, 1, 0xF},  // U+2508 ┈
+  {2, 2, 1, 1, 0xF},
+  {0, 2, 1, 2, 0xF},  // U+2509 ┉
+  {2, 2, 1, 2, 0xF},
+  {1, 0, 1, 1, 0xF},  // U+250A ┊
+  {1, 2, 1, 1, 0xF},
+  {1, 4, 1, 1, 0xF},
+  {1, 0, 2, 1, 0xF},  // U+250B ┋
+  {1, 2, 2, 1, 0xF},
+  {1, 4, 2, 1, 0xF},
+  {1, 2, 1, 4, 0xF},  // U+250C ┌
+  {2, 2, 2, 1, 0xF},
+  {1, 2, 3, 2, 0xF},  // U+250D ┍
+  {1, 4, 1, 2, 0xF},
+  {1, 2, 2, 4, 0xF},  // U+250E ┎
+  {3, 2, 1, 1, 0xF},
+  {1, 2, 2, 4, 0xF},  // U+250F ┏
+  {3, 2, 1, 2, 0xF},
+  {0, 2, 2, 1, 0xF},  // U+2510 ┐
+  {1, 3, 1, 3, 0xF},
+  {0, 2, 2, 2, 0xF},  // U+2511 ┑
+  {1, 4, 1, 2, 0xF},
+  {0, 2, 3, 1, 0xF},  // U+2512 ┒
+  {1, 3, 2, 3, 0xF},
+  {0, 2, 3, 2, 0xF},  // U+2513 ┓
+  {1, 4, 2, 2, 0xF},
+  {1, 0, 1, 3, 0xF},  // U+2514 └
+  {2, 2, 2, 1, 0xF},
+  {1, 0, 1, 4, 0xF},  // U+2515 ┕
+  {2, 2, 2, 2, 0xF},
+  {1, 0, 2, 3, 0xF},  // U+2516 ┖
+  {3, 2, 1, 1, 0xF},
+  {1, 0, 2, 4, 0xF},  // U+2517 ┗
+  {3, 2, 1, 2, 0xF},
+  {1, 0, 1, 3, 0xF},  // U+2518 ┘
+  {0, 2, 2, 1, 0xF},
+  {1, 0, 1, 4, 0xF},  // U+2519 ┙
+  {0, 2, 2, 2, 0xF},
+  {1, 0, 2, 3, 0xF},  // U+251A ┚
+  {0, 2, 3, 1, 0xF},
+  {1, 0, 2, 4, 0xF},  // U+251B ┛
+  {0, 2, 3, 2, 0xF},
+  {1, 0, 1, 6, 0xF},  // U+251C ├
+  {2, 2, 2, 1, 0xF},
+  {1, 0, 1, 6, 0xF},  // U+251D ┝
+  {2, 2, 2, 2, 0xF},
+  {1, 0, 2, 3, 0xF},  // U+251E ┞
+  {3, 2, 1, 1, 0xF},
+  {1, 3, 1, 3, 0xF},
+  {1, 0, 1, 6, 0xF},  // U+251F ┟
+  {2, 2, 1, 4, 0xF},
+  {3, 2, 1, 1, 0xF},
+  {1, 0, 2, 6, 0xF},  // U+2520 ┠
+  {3, 2, 1, 1, 0xF},
+  {1, 0, 2, 4, 0xF},  // U+2521 ┡
+  {3, 2, 1, 2, 0xF},
+  {1, 4, 1, 2, 0xF},
+  {1, 0, 1, 6, 0xF},  // U+2522 ┢
+  {2, 2, 2, 2, 0xF},
+  {2, 4, 1, 2, 0xF},
+  {1, 0, 2, 6, 0xF},  // U+2523 ┣
+  {3, 2, 1, 2, 0xF},
+  {1, 0, 1, 6, 0xF},  // U+2524 ┤
+  {0, 2, 2, 1, 0xF},
+  {1, 0, 1, 6, 0xF},  // U+2525 ┥
+  {0, 2, 2, 2, 0xF},
+  {1, 0, 2, 3, 0xF},  // U+2526 ┦
+  {0, 2, 3, 1, 0xF},
+  {1, 3, 1, 3, 0xF},
+  {1, 0, 1, 6, 0xF},  // U+2527 ┧
+  {0, 2, 3, 1, 0xF},
+  {2, 3, 1, 3, 0xF},
+  {1, 0, 2, 6, 0xF},  // U+2528 ┨
+  {0, 2, 3, 1, 0xF},
+  {1, 0, 2, 4, 0xF},  // U+2529 ┩
+  {0, 2, 3, 2, 0xF},
+  {1, 4, 1, 2, 0xF},
+  {1, 0, 1, 6, 0xF},  // U+252A ┪
+  {0, 2, 3, 2, 0xF},
+  {2, 4, 1, 2, 0xF},
+  {1, 0, 2, 6, 0xF},  // U+252B ┫
+  {0, 2, 3, 2, 0xF},
+  {0, 2, 4, 1, 0xF},  // U+252C ┬
+  {1, 3, 1, 3, 0xF},
+  {0, 2, 4, 1, 0xF},  // U+252D ┭
+  {0, 3, 2, 1, 0xF},
+  {1, 4, 1, 2, 0xF},
+  {0, 2, 4, 1, 0xF},  // U+252E ┮
+  {1, 3, 3, 1, 0xF},
+  {1, 4, 1, 2, 0xF},
+  {0, 2, 4, 2, 0xF},  // U+252F ┯
+  {1, 4, 1, 2, 0xF},
+  {0, 2, 4, 1, 0xF},  // U+2530 ┰
+  {1, 3, 2, 3, 0xF},
+  {0, 2, 3, 2, 0xF},  // U+2531 ┱
+  {3, 2, 1, 1, 0xF},
+  {1, 4, 2, 2, 0xF},
+  {0, 2, 4, 1, 0xF},  // U+2532 ┲
+  {1, 3, 2, 3, 0xF},
+  {3, 3, 1, 1, 0xF},
+  {0, 2, 4, 2, 0xF},  // U+2533 ┳
+  {1, 4, 2, 2, 0xF},
+  {1, 0, 1, 3, 0xF},  // U+2534 ┴
+  {0, 2, 4, 1, 0xF},
+  {1, 0, 1, 4, 0xF},  // U+2535 ┵
+  {0, 2, 4, 1, 0xF},
+  {0, 3, 2, 1, 0xF},
+  {1, 0, 1, 4, 0xF},  // U+2536 ┶
+  {0, 2, 4, 1, 0xF},
+  {2, 3, 2, 1, 0xF},
+  {1, 0, 1, 4, 0xF},  // U+2537 ┷
+  {0, 2, 4, 2, 0xF},
+  {1, 0, 2, 3, 0xF},  // U+2538 ┸
+  {0, 2, 4, 1, 0xF},
+  {1, 0, 2, 4, 0xF},  // U+2539 ┹
+  {0, 2, 4, 1, 0xF},
+  {0, 3, 3, 1, 0xF},
+  {1, 0, 2, 4, 0xF},  // U+253A ┺
+  {0, 2, 4, 1, 0xF},
+  {3, 3, 1, 1, 0xF},
+  {1, 0, 2, 4, 0xF},  // U+253B ┻
+  {0, 2, 4, 2, 0xF},
+  {1, 0, 1, 6, 0xF},  // U+253C ┼
+  {0, 2, 4, 1, 0xF},
+  {1, 0, 1, 6, 0xF},  // U+253D ┽
+  {0, 2, 4, 1, 0xF},
+  {0, 3, 2, 1, 0xF},
+  {1, 0, 1, 6, 0xF},  // U+253E ┾
+  {0, 2, 4, 1, 0xF},
+  {2, 3, 2, 1, 0xF},
+  {1, 0, 1, 6, 0xF},  // U+253F ┿
+  {0, 2, 4, 2, 0xF},
+  {1, 0, 2, 3, 0xF},  // U+2540 ╀
+  {0, 2, 4, 1, 0xF},
+  {1, 3, 1, 3, 0xF},
+  {1, 0, 1, 6, 0xF},  // U+2541 ╁
+  {0, 2, 4, 1, 0xF},
+  {2, 3, 1, 3, 0xF},
+  {1, 0, 2, 6, 0xF},  // U+2542 ╂
+  {0, 2, 4, 1, 0xF},
+  {1, 0, 2, 4, 0xF},  // U+2543 ╃
+  {0, 2, 4, 1, 0xF},
+  {0, 3, 3, 1, 0xF},
+  {1, 4, 1, 2, 0xF},
+  {1, 0, 2, 4, 0xF},  // U+2544 ╄
+  {0, 2, 4, 1, 0xF},
+  {3, 3, 1, 1, 0xF},
+  {1, 4, 1, 2, 0xF},
+  {1, 0, 1, 6, 0xF},  // U+2545 ╅
+  {0, 2, 3, 2, 0xF},
+  {3, 2, 1, 1, 0xF},
+  {2, 4, 1, 2, 0xF},
+  {1, 0, 1, 6, 0xF},  // U+2546 ╆
+  {0, 2, 4, 1, 0xF},
+  {2, 3, 1, 3, 0xF},
+  {3, 3, 1, 1, 0xF},
+  {1, 0, 2, 4, 0xF},  // U+2547 ╇
+  {0, 2, 4, 2, 0xF},
+  {1, 4, 1, 2, 0xF},
+  {1, 0, 1, 6, 0xF},  // U+2548 ╈
+  {0, 2, 4, 2, 0xF},
+  {2, 4, 1, 2, 0xF},
+  {1, 0, 2, 6, 0xF},  // U+2549 ╉
+  {0, 2, 4, 1, 0xF},
+  {0, 3, 3, 1, 0xF},
+  {1, 0, 2, 6, 0xF},  // U+254A ╊
+  {0, 2, 4, 1, 0xF},
+  {3, 3, 1, 1, 0xF},
+  {1, 0, 2, 6, 0xF},  // U+254B ╋
+  {0, 2, 4, 2, 0xF},
+  {0, 2, 1, 1, 0xF},  // U+254C ╌
+  {2, 2, 1, 1, 0xF},
+  {0, 2, 1, 2, 0xF},  // U+254D ╍
+  {2, 2, 1, 2, 0xF},
+  {1, 0, 1, 2, 0xF},  // U+254E ╎
+  {1, 3, 1, 2, 0xF},
+  {1, 0, 2, 2, 0xF},  // U+254F ╏
+  {1, 3, 2, 2, 0xF},
+  {0, 1, 4, 1, 0xF},  // U+2550 ═
+  {0, 3, 4, 1, 0xF},
+  {0, 0, 1, 6, 0xF},  // U+2551 ║
+  {2, 0, 1, 6, 0xF},
+  {1, 1, 1, 5, 0xF},  // U+2552 ╒
+  {2, 1, 2, 1, 0xF},
+  {2, 3, 2, 1, 0xF},
+  {0, 2, 4, 1, 0xF},  // U+2553 ╓
+  {0, 3, 1, 3, 0xF},
+  {2, 3, 1, 3, 0xF},
+  {0, 1, 1, 5, 0xF},  // U+2554 ╔
+  {1, 1, 3, 1, 0xF},
+  {2, 3, 1, 3, 0xF},
+  {3, 3, 1, 1, 0xF},
+  {0, 1, 2, 1, 0xF},  // U+2555 ╕
+  {1, 2, 1, 4, 0xF},
+  {0, 3, 2, 1, 0xF},
+  {0, 2, 1, 4, 0xF},  // U+2556 ╖
+  {1, 2, 2, 1, 0xF},
+  {2, 3, 1, 3, 0xF},
+  {0, 1, 3, 1, 0xF},  // U+2557 ╗
+  {2, 2, 1, 4, 0xF},
+  {0, 3, 1, 3, 0xF},
+  {1, 0, 1, 4, 0xF},  // U+2558 ╘
+  {2, 1, 2, 1, 0xF},
+  {2, 3, 2, 1, 0xF},
+  {0, 0, 1, 3, 0xF},  // U+2559 ╙
+  {2, 0, 1, 3, 0xF},
+  {1, 2, 3, 1, 0xF},
+  {0, 0, 1, 4, 0xF},  // U+255A ╚
+  {2, 0, 1, 2, 0xF},
+  {3, 1, 1, 1, 0xF},
+  {1, 3, 3, 1, 0xF},
+  {1, 0, 1, 4, 0xF},  // U+255B ╛
+  {0, 1, 2, 1, 0xF},
+  {0, 3, 2, 1, 0xF},
+  {0, 0, 1, 3, 0xF},  // U+255C ╜
+  {2, 0, 1, 3, 0xF},
+  {1, 2, 2, 1, 0xF},
+  {0, 0, 1, 2, 0xF},  // U+255D ╝
+  {2, 0, 1, 4, 0xF},
+  {0, 3, 3, 1, 0xF},
+  {1, 0, 1, 6, 0xF},  // U+255E ╞
+  {2, 1, 2, 1, 0xF},
+  {2, 3, 2, 1, 0xF},
+  {0, 0, 1, 6, 0xF},  // U+255F ╟
+  {2, 0, 1, 6, 0xF},
+  {3, 2, 1, 1, 0xF},
+  {0, 0, 1, 6, 0xF},  // U+2560 ╠
+  {2, 0, 1, 2, 0xF},
+  {3, 1, 1, 1, 0xF},
+  {2, 3, 1, 3, 0xF},
+  {3, 3, 1, 1, 0xF},
+  {1, 0, 1, 6, 0xF},  // U+2561 ╡
+  {0, 1, 2, 1, 0xF},
+  {0, 3, 2, 1, 0xF},
+  {0, 0, 1, 6, 0xF},  // U+2562 ╢
+  {2, 0, 1, 6, 0xF},
+  {0, 0, 1, 2, 0xF},  // U+2563 ╣
+  {2, 0, 1, 6, 0xF},
+  {0, 3, 1, 3, 0xF},
+  {0, 1, 4, 1, 0xF},  // U+2564 ╤
+  {0, 3, 4, 1, 0xF},
+  {1, 4, 1, 2, 0xF},
+  {0, 2, 4, 1, 0xF},  // U+2565 ╥
+  {0, 3, 1, 3, 0xF},
+  {2, 3, 1, 3, 0xF},
+  {0, 1, 4, 1, 0xF},  // U+2566 ╦
+  {0, 3, 1, 3, 0xF},
+  {2, 3, 1, 3, 0xF},
+  {3, 3, 1, 1, 0xF},
+  {1, 0, 1, 2, 0xF},  // U+2567 ╧
+  {0, 1, 4, 1, 0xF},
+  {0, 3, 4, 1, 0xF},
+  {0, 0, 1, 3, 0xF},  // U+2568 ╨
+  {2, 0, 1, 3, 0xF},
+  {1, 2, 3, 1, 0xF},
+  {0, 0, 1, 2, 0xF},  // U+2569 ╩
+  {2, 0, 1, 2, 0xF},
+  {3, 1, 1, 1, 0xF},
+  {0, 3, 4, 1, 0xF},
+  {1, 0, 1, 2, 0xF},  // U+256A ╪
+  {0, 1, 4, 1, 0xF},
+  {0, 3, 4, 1, 0xF},
+  {1, 4, 1, 2, 0xF},
+  {0, 0, 1, 6, 0xF},  // U+256B ╫
+  {2, 0, 1, 6, 0xF},
+  {3, 2, 1, 1, 0xF},
+  {0, 0, 1, 2, 0xF},  // U+256C ╬
+  {2, 0, 1, 2, 0xF},
+  {3, 1, 1, 1, 0xF},
+  {0, 3, 1, 3, 0xF},
+  {2, 3, 1, 3, 0xF},
+  {3, 3, 1, 1, 0xF},
+  {2, 2, 2, 1, 0xF},  // U+256D ╭
+  {1, 3, 1, 3, 0xF},
+  {0, 2, 1, 1, 0xF},  // U+256E ╮
+  {1, 3, 1, 3, 0xF},
+  {1, 0, 1, 2, 0xF},  // U+256F ╯
+  {0, 2, 1, 1, 0xF},
+  {1, 0, 1, 2, 0xF},  // U+2570 ╰
+  {2, 2, 2, 1, 0xF},
+  {3, 0, 1, 2, 0xF},  // U+2571 ╱
+  {2, 2, 1, 1, 0xF},
+  {1, 3, 1, 2, 0xF},
+  {0, 5, 1, 1, 0xF},
+  {0, 0, 1, 2, 0xF},  // U+2572 ╲
+  {1, 2, 1, 1, 0xF},
+  {2, 3, 1, 2, 0xF},
+  {3, 5, 1, 1, 0xF},
+  {0, 0, 1, 2, 0xF},  // U+2573 ╳
+  {3, 0, 1, 2, 0xF},
+  {1, 2, 2, 3, 0xF},
+  {0, 5, 1, 1, 0xF},
+  {3, 5, 1, 1, 0xF},
+  {0, 2, 2, 1, 0xF},  // U+2574 ╴
+  {1, 0, 1, 3, 0xF},  // U+2575 ╵
+  {1, 2, 3, 1, 0xF},  // U+2576 ╶
+  {1, 2, 1, 4, 0xF},  // U+2577 ╷
+  {0, 2, 2, 2, 0xF},  // U+2578 ╸
+  {1, 0, 2, 3, 0xF},  // U+2579 ╹
+  {1, 2, 3, 2, 0xF},  // U+257A ╺
+  {1, 2, 2, 4, 0xF},  // U+257B ╻
+  {0, 2, 4, 1, 0xF},  // U+257C ╼
+  {1, 3, 3, 1, 0xF},
+  {1, 0, 1, 6, 0xF},  // U+257D ╽
+  {2, 2, 1, 4, 0xF},
+  {0, 2, 4, 1, 0xF},  // U+257E ╾
+  {0, 3, 2, 1, 0xF},
+  {1, 0, 2, 3, 0xF},  // U+257F ╿
+  {1, 3, 1, 3, 0xF},
+  {0, 0, 4, 3, 0xF},  // U+2580 ▀
+  {0, 5, 4, 1, 0xF},  // U+2581 ▁
+  {0, 4, 4, 2, 0xF},  // U+2582 ▂
+  {0, 4, 4, 2, 0xF},  // U+2583 ▃
+  {0, 3, 4, 3, 0xF},  // U+2584 ▄
+  {0, 2, 4, 4, 0xF},  // U+2585 ▅
+  {0, 1, 4, 5, 0xF},  // U+2586 ▆
+  {0, 1, 4, 5, 0xF},  // U+2587 ▇
+  {0, 0, 4, 6, 0xF},  // U+2588 █
+  {0, 0, 4, 6, 0xF},  // U+2589 ▉
+  {0, 0, 3, 6, 0xF},  // U+258A ▊
+  {0, 0, 3, 6, 0xF},  // U+258B ▋
+  {0, 0, 2, 6, 0xF},  // U+258C ▌
+  {0, 0, 2, 6, 0xF},  // U+258D ▍
+  {0, 0, 1, 6, 0xF},  // U+258E ▎
+  {0, 0, 1, 6, 0xF},  // U+258F ▏
+  {2, 0, 2, 6, 0xF},  // U+2590 ▐
+  {0, 0, 4, 6, 0x1},  // U+2591 ░
+  {0, 0, 4, 6, 0x9},  // U+2592 ▒
+  {0, 0, 4, 6, 0x7},  // U+2593 ▓
+  {0, 0, 4, 1, 0xF},  // U+2594 ▔
+  {3, 0, 1, 6, 0xF},  // U+2595 ▕
+  {0, 3, 2, 3, 0xF},  // U+2596 ▖
+  {2, 3, 2, 3, 0xF},  // U+2597 ▗
+  {0, 0, 2, 3, 0xF},  // U+2598 ▘
+  {0, 0, 2, 6, 0xF},  // U+2599 ▙
+  {2, 3, 2, 3, 0xF},
+  {0, 0, 2, 3, 0xF},  // U+259A ▚
+  {2, 3, 2, 3, 0xF},
+  {0, 0, 4, 3, 0xF},  // U+259B ▛
+  {0, 3, 2, 3, 0xF},
+  {0, 0, 4, 3, 0xF},  // U+259C ▜
+  {2, 3, 2, 3, 0xF},
+  {2, 0, 2, 3, 0xF},  // U+259D ▝
+  {2, 0, 2, 3, 0xF},  // U+259E ▞
+  {0, 3, 2, 3, 0xF},
+  {2, 0, 2, 6, 0xF},  // U+259F ▟
+  {0, 3, 4, 3, 0xF},
+};
+
+// Shapes of each cell font, in glyphFonts order
+struct GlyphShapeFont {
+  const uint16_t* start;
+  const GlyphRect* rects;
+};
+
+static const GlyphShapeFont glyphShapeFonts[2] = {
+  {glyphShapeStart6x8, glyphShapeRects6x8},
+  {glyphShapeStart4x6, glyphShapeRects4x6},
+};
+
+#endif
@@ -5,6 +5,7 @@
 #include "keyboard.h"
 #include "display.h"
 #include "terminal.h"
+#include "renderer.h"
 #include "utf8.h"
 
 // Keyboard layouts
@@ -58,6 +59,51 @@ static int inputBufferPos = 0;
 static int currentHistoryIndex = -1;  // Current position in history (-1 = new command, 0 = most recent)
 static String savedNewCommand = "";   // Save current unfinished command when browsing history
 
+// Search query (UTF-8) - while FIND is on, typed keys edit it instead of the input line
+#define SEARCH_BUFFER_SIZE (SEARCH_MAX_QUERY * 2 + 1)
+static char searchBuffer[SEARCH_BUFFER_SIZE];
+static int searchBufferPos = 0;
+
+// Type text into the search query, returns false if not searching
+static bool searchType(const char* text) {
+  if (!terminalSearchActive()) return false;
+  
+  int len = strlen(text);
+  if (searchBufferPos + len < SEARCH_BUFFER_SIZE) {
+    memcpy(searchBuffer + searchBufferPos, text, len);
+    searchBufferPos += len;
+    searchBuffer[searchBufferPos] = '\0';
+    terminalSearchSetQuery(searchBuffer);
+  }
+  return true;
+}
+
+// Delete the last query character, returns false if not searching
+static bool searchBackspace() {
+  if (!terminalSearchActive()) return false;
+  
+  if (searchBufferPos > 0) {
+    searchBufferPos--;
+    while (searchBufferPos > 0 && (searchBuffer[searchBufferPos] & 0xC0) == 0x80) {
+      searchBufferPos--;
+    }
+    searchBuffer[searchBufferPos] = '\0';
+    terminalSearchSetQuery(searchBuffer);
+  }
+  return true;
+}
+
+static void toggleSearch() {
+  if (terminalSearchActive()) {
+    terminalSearchStop();
+  } else {
+    searchBufferPos = 0;
+    searchBuffer[0] = '\0';
+    terminalSearchStart();
+  }
+  showKeyboard();
+}
+
 void saveCommandToHistory(const String& command) {
   if (command.length() == 0) return;
   
@@ -198,10 +244,7 @@ void drawKey(int row, int col, const char* key, int keyW = keyWidth) {
     // Key is 28px wide, font is 12px wide, so (28-12)/2 = 8px offset
     drawUnicodeChar(codepoint, x + 8, y + 7, TFT_WHITE, TFT_DARKGREY, 2);
   } else {
-    // English/Symbols - ASCII
-    tft.setTextSize(2);
-    tft.setTextColor(TFT_WHITE, TFT_DARKGREY);
-    
+    // English/Symbols - ASCII, same 2x glyphs as the Russian keys
     char displayChar = key[0];
     
     // Apply shift for English lowercase
@@ -209,11 +252,7 @@ void drawKey(int row, int col, const char* key, int keyW = keyWidth) {
       displayChar = displayChar - 32; // Uppercase
     }
     
-    int textX = x + 9;
-    int textY = y + 8;
-    
-    tft.setCursor(textX, textY);
-    tft.print(displayChar);
+    drawUnicodeChar(displayChar, x + 9, y + 8, TFT_WHITE, TFT_DARKGREY, 2);
   }
 }
 
@@ -270,7 +309,8 @@ void showKeyboard() {
     // Navigation layout - arrows and control keys
     int baseY = KEYBOARD_Y_POS;
     
-    // Row 0: UP arrow (centered)
+    // Row 0: FIND, UP arrow (centered)
+    drawSpecialKey(terminalSearchActive() ? "FIND*" : "FIND", 5, baseY, 50);
     drawSpecialKey("UP", 135, baseY, 50);
     
     // Row 1: LEFT DOWN RIGHT arrows
@@ -325,6 +365,10 @@ void showKeyboard() {
 void hideKeyboard() {
   // Clear keyboard area
   tft.fillRect(0, KEYBOARD_Y_POS, SCREEN_WIDTH, KEYBOARD_HEIGHT, TFT_BLACK);
+  rendererSetGlass(0, KEYBOARD_Y_POS, SCREEN_WIDTH, KEYBOARD_HEIGHT, TFT_BLACK);
+  
+  // Search needs the keyboard for its query
+  if (terminalSearchActive()) terminalSearchStop();
   
   // Redraw terminal content in that area
   // Note: This will be called from toggleKeyboard which then calls terminalScrollForKeyboard
@@ -390,6 +434,8 @@ void handleKeyboardTouch() {
     }
     // SPACE (155, 60)
     else if (touchX >= 155 && touchX <= 215) {
+      if (searchType(" ")) return;
+      
       // Add to input buffer
       if (inputBufferPos < INPUT_BUFFER_SIZE - 1) {
         inputBuffer[inputBufferPos++] = ' ';
@@ -400,6 +446,8 @@ void handleKeyboardTouch() {
     }
     // BKSP (220, 45)
     else if (touchX >= 220 && touchX <= 265) {
+      if (searchBackspace()) return;
+      
       // Remove last byte from input buffer
       if (inputBufferPos > 0) {
         inputBufferPos--;
@@ -415,6 +463,12 @@ void handleKeyboardTouch() {
     }
     // ENTER (270, 45)
     else if (touchX >= 270 && touchX <= 315) {
+      // While searching ENTER jumps to the previous (older) match
+      if (terminalSearchActive()) {
+        terminalSearchNext(true);
+        return;
+      }
+      
       // Send accumulated input buffer
       if (inputBufferPos > 0) {
         inputBuffer[inputBufferPos] = '\0'; // Null-terminate
@@ -457,6 +511,9 @@ void handleKeyboardTouch() {
               showKeyboard();
             }
             
+            char keyStr[2] = {key, 0};
+            if (searchType(keyStr)) return;
+            
             // Add to input buffer
             if (inputBufferPos < INPUT_BUFFER_SIZE - 1) {
               inputBuffer[inputBufferPos++] = key;
@@ -522,6 +579,8 @@ void handleKeyboardTouch() {
               utf8len = 2;
             }
             
+            if (searchType(utf8char)) return;
+            
             // Add to input buffer
             for (int j = 0; j < utf8len && inputBufferPos < INPUT_BUFFER_SIZE - 1; j++) {
               inputBuffer[inputBufferPos++] = utf8char[j];
@@ -548,6 +607,8 @@ void handleKeyboardTouch() {
           
           if (touchX >= x && touchX <= x + keyWidth) {
             char key = keyboardSYM[row][col];
+            char keyStr[2] = {key, 0};
+            if (searchType(keyStr)) return;
             
             // Add to input buffer
             if (inputBufferPos < INPUT_BUFFER_SIZE - 1) {
@@ -565,10 +626,17 @@ void handleKeyboardTouch() {
     // Navigation layout
     int baseY = KEYBOARD_Y_POS;
     
-    // Row 0: UP arrow
+    // Row 0: FIND, UP arrow (UP and DOWN step through matches while searching)
     if (touchY >= baseY && touchY <= baseY + keyHeight) {
-      if (touchX >= 135 && touchX <= 185) {
-        historyUp();
+      if (touchX >= 5 && touchX <= 55) {
+        toggleSearch();
+        return;
+      } else if (touchX >= 135 && touchX <= 185) {
+        if (terminalSearchActive()) {
+          terminalSearchNext(true);
+        } else {
+          historyUp();
+        }
         return;
       }
     }
@@ -580,7 +648,11 @@ void handleKeyboardTouch() {
         // LEFT - future: move cursor left
         return;
       } else if (touchX >= 140 && touchX <= 190) {
-        historyDown();
+        if (terminalSearchActive()) {
+          terminalSearchNext(false);
+        } else {
+          historyDown();
+        }
         return;
       } else if (touchX >= 195 && touchX <= 245) {
         // RIGHT - future: move cursor right
@@ -0,0 +1,470 @@
+/*
+ * reflow.cpp - Lazy reflow of scrollback rows
+ *
+ * Each cell font numbers the display rows of the whole history from an
+ * arbitrary origin (positions). tailPos is the position where the open
+ * line starts - the rows after the last finished logical line, all
+ * soft-wrapped so far. Pushes keep tailPos of every font up to date from
+ * the row lengths alone, so the end of the history never has to be found
+ * by walking it, and depth d is the position end - d.
+ *
+ * A finished line of L cells takes L / cols rows rounded up, at least one.
+ * The terminal wraps as soon as the last column is written, so a line that
+ * ended on the empty row it wrapped onto counts one cell more: when its
+ * cells fill its rows exactly it keeps that empty row, the way it was shown
+ * live.
+ *
+ * Every font caches a window of logical lines with their positions. It is
+ * only extended (backwards from the newest line, or forwards again) as far
+ * as rows are asked for, so only shown lines ever get their rows measured.
+ */
+
+#include "reflow.h"
+#include "scrollback.h"
+#include "utf8.h"
+
+// Logical line starting at stored row first, its first row at position pos
+struct ReflowLine {
+  uint32_t first;
+  int32_t pos;
+};
+
+// Cached lines of one cell font: a ring of count lines from head, covering
+// stored rows up to coverEnd (at position coverEndPos)
+struct ReflowCache {
+  int cols;
+  int32_t tailPos;
+  ReflowLine lines[REFLOW_CACHE_LINES];
+  int head;
+  int count;
+  uint32_t coverEnd;
+  int32_t coverEndPos;
+};
+
+static ReflowCache caches[CELL_FONT_COUNT];
+static ReflowCache* cache = &caches[0];
+
+// Open line: stored rows [openFirst, scrollbackEndLine()), openLength cells
+static uint32_t openFirst = 0;
+static uint32_t openLength = 0;
+
+// Rows of a finished logical line (wrapEnd: it ended on the empty row it
+// wrapped onto) and of an open one
+static int32_t lineHeight(uint32_t length, bool wrapEnd, int cols) {
+  if (wrapEnd) length++;
+  return length > 0 ? (length + cols - 1) / cols : 1;
+}
+
+static int32_t openHeight(uint32_t length, int cols) {
+  return (length + cols - 1) / cols;
+}
+
+// Position right after the newest history row
+static int32_t endPos() {
+  return cache->tailPos + openHeight(openLength, cache->cols);
+}
+
+static ReflowLine& cachedLine(int i) {
+  return cache->lines[(cache->head + i) % REFLOW_CACHE_LINES];
+}
+
+// Oldest cached row and its position
+static uint32_t frontRow() {
+  return cache->count > 0 ? cachedLine(0).first : cache->coverEnd;
+}
+
+static int32_t frontPos() {
+  return cache->count > 0 ? cachedLine(0).pos : cache->coverEndPos;
+}
+
+// Empty window at the open line
+static void resetCover(ReflowCache* c) {
+  c->head = 0;
+  c->count = 0;
+  c->coverEnd = openFirst;
+  c->coverEndPos = c->tailPos;
+}
+
+// Drop cached lines that lost rows to eviction
+static void prune() {
+  uint32_t oldest = scrollbackFirstLine();
+  while (cache->count > 0 && cachedLine(0).first < oldest) {
+    cache->head = (cache->head + 1) % REFLOW_CACHE_LINES;
+    cache->count--;
+  }
+  if (cache->count == 0 && cache->coverEnd < oldest) resetCover(cache);
+}
+
+// First row, length and wrapEnd of the logical line that ends with row
+// last, rows before oldest not counted. Returns false if a row can't be
+// read yet.
+static bool lineEndingAt(uint32_t last, uint32_t oldest, uint32_t* first, uint32_t* length, bool* wrapEnd) {
+  int rowLength;
+  bool wrapped;
+  if (!scrollbackGetLineInfo(last, &rowLength, &wrapped)) return false;
+  bool emptyLast = rowLength == 0;
+  uint32_t row = last;
+  uint32_t total = rowLength;
+  while (row > oldest) {
+    if (!scrollbackGetLineInfo(row - 1, &rowLength, &wrapped)) return false;
+    if (!wrapped) break;
+    total += rowLength;
+    row--;
+  }
+  *first = row;
+  *length = total;
+  *wrapEnd = emptyLast && row < last;
+  return true;
+}
+
+// End row, length and wrapEnd of the logical line starting at row first,
+// ending at limit at the latest
+static bool lineStartingAt(uint32_t first, uint32_t limit, uint32_t* end, uint32_t* length, bool* wrapEnd) {
+  uint32_t row = first;
+  uint32_t total = 0;
+  int rowLength = 0;
+  while (row < limit) {
+    bool wrapped;
+    if (!scrollbackGetLineInfo(row, &rowLength, &wrapped)) return false;
+    total += rowLength;
+    row++;
+    if (!wrapped) break;
+  }
+  *end = row;
+  *length = total;
+  *wrapEnd = rowLength == 0 && row > first + 1;
+  return true;
+}
+
+// Cells of a logical line before stored row line
+static bool lineOffset(uint32_t first, uint32_t line, uint32_t* offset) {
+  *offset = 0;
+  for (uint32_t row = first; row < line; row++) {
+    int rowLength;
+    bool wrapped;
+    if (!scrollbackGetLineInfo(row, &rowLength, &wrapped)) return false;
+    *offset += rowLength;
+  }
+  return true;
+}
+
+// Cache the line before the oldest cached one: 1 if done, 0 if there is
+// none, -1 if its rows can't be read yet
+static int stepBack() {
+  uint32_t front = frontRow();
+  if (front <= scrollbackFirstLine()) return 0;
+  
+  uint32_t first, length;
+  bool wrapEnd;
+  if (!lineEndingAt(front - 1, scrollbackFirstLine(), &first, &length, &wrapEnd)) return -1;
+  int32_t pos = frontPos() - lineHeight(length, wrapEnd, cache->cols);
+  
+  // A full window forgets its newest line
+  if (cache->count == REFLOW_CACHE_LINES) {
+    ReflowLine& newest = cachedLine(cache->count - 1);
+    cache->coverEnd = newest.first;
+    cache->coverEndPos = newest.pos;
+    cache->count--;
+  }
+  cache->head = (cache->head + REFLOW_CACHE_LINES - 1) % REFLOW_CACHE_LINES;
+  cache->count++;
+  cachedLine(0).first = first;
+  cachedLine(0).pos = pos;
+  return 1;
+}
+
+// Cache the line after the newest cached one, like stepBack()
+static int stepForward() {
+  if (cache->coverEnd >= openFirst) return 0;
+  
+  uint32_t end, length;
+  bool wrapEnd;
+  if (!lineStartingAt(cache->coverEnd, openFirst, &end, &length, &wrapEnd)) return -1;
+  
+  // A full window forgets its oldest line
+  if (cache->count == REFLOW_CACHE_LINES) {
+    cache->head = (cache->head + 1) % REFLOW_CACHE_LINES;
+    cache->count--;
+  }
+  cachedLine(cache->count).first = cache->coverEnd;
+  cachedLine(cache->count).pos = cache->coverEndPos;
+  cache->count++;
+  cache->coverEnd = end;
+  cache->coverEndPos += lineHeight(length, wrapEnd, cache->cols);
+  return 1;
+}
+
+// Index of the newest cached line that starts at or before a position (or
+// a stored row)
+static int findCached(int32_t pos, bool byRow) {
+  int lo = 0;
+  int hi = cache->count - 1;
+  while (lo < hi) {
+    int mid = (lo + hi + 1) / 2;
+    const ReflowLine& line = cachedLine(mid);
+    if (byRow ? line.first <= (uint32_t)pos : line.pos <= pos) {
+      lo = mid;
+    } else {
+      hi = mid - 1;
+    }
+  }
+  return lo;
+}
+
+// Logical line holding the row at a position: its stored rows [first, end)
+// and the position of its first row
+static bool locate(int32_t pos, uint32_t* first, uint32_t* end, int32_t* linePos) {
+  prune();
+  if (pos >= cache->tailPos) {
+    *first = openFirst;
+    *end = scrollbackEndLine();
+    *linePos = cache->tailPos;
+    return true;
+  }
+  
+  // Below the window: walk on from it, or start over from the newest line
+  // if that is closer
+  if (pos >= cache->coverEndPos) {
+    if (cache->count == 0 || cache->tailPos - pos < pos - cache->coverEndPos) resetCover(cache);
+    while (pos >= cache->coverEndPos) {
+      if (stepForward() <= 0) return false;
+    }
+  }
+  while (pos < frontPos()) {
+    if (stepBack() <= 0) return false;
+  }
+  
+  int i = findCached(pos, false);
+  *first = cachedLine(i).first;
+  *end = i + 1 < cache->count ? cachedLine(i + 1).first : cache->coverEnd;
+  *linePos = cachedLine(i).pos;
+  return true;
+}
+
+// Cells of row seg of the logical line in stored rows [first, end)
+static bool copySegment(uint32_t first, uint32_t end, int32_t seg, TermCell* cells, int count) {
+  int cols = cache->cols;
+  
+  // A line of one row starts with that row
+  if (seg == 0 && end - first == 1 && count <= cols) return scrollbackGetLine(first, cells, count);
+  
+  for (int x = 0; x < count; x++) {
+    cells[x].glyph = ' ';
+    cells[x].colors = CELL_DEFAULT_COLORS;
+  }
+  int32_t from = seg * cols;
+  int32_t offset = 0;
+  for (uint32_t row = first; row < end && offset < from + cols; row++) {
+    int length;
+    bool wrapped;
+    if (!scrollbackGetLineInfo(row, &length, &wrapped)) return false;
+    if (offset + length > from) {
+      TermCell rowCells[TERMINAL_MAX_COLS];
+      if (!scrollbackGetLine(row, rowCells, TERMINAL_MAX_COLS)) return false;
+      for (int x = 0; x < length; x++) {
+        int32_t at = offset + x - from;
+        if (at >= 0 && at < cols && at < count) cells[at] = rowCells[x];
+      }
+    }
+    offset += length;
+  }
+  return true;
+}
+
+void reflowClear() {
+  openFirst = 0;
+  openLength = 0;
+  for (int f = 0; f < CELL_FONT_COUNT; f++) {
+    caches[f].cols = SCREEN_WIDTH / cellFontWidth(f);
+    caches[f].tailPos = 0;
+    resetCover(&caches[f]);
+  }
+}
+
+void reflowSetFont(int font) {
+  cache = &caches[font];
+}
+
+void reflowPushRow(const TermCell* cells, int count, bool wrapped) {
+  // Length as stored: a finished row loses its trailing blanks
+  if (!wrapped) {
+    while (count > 0 && cellIsBlank(cells[count - 1])) count--;
+  }
+  scrollbackPushLine(cells, count, wrapped);
+  bool wrapEnd = !wrapped && count == 0 && openFirst < scrollbackEndLine() - 1;
+  openLength += count;
+  if (wrapped) return;
+  
+  // The open line is finished, every font gets its rows. A window that
+  // reaches it takes it in, so it doesn't have to start over when the
+  // newest rows are shown.
+  for (int f = 0; f < CELL_FONT_COUNT; f++) {
+    ReflowCache* c = &caches[f];
+    int32_t height = lineHeight(openLength, wrapEnd, c->cols);
+    if (c->coverEnd == openFirst) {
+      if (c->count == REFLOW_CACHE_LINES) {
+        c->head = (c->head + 1) % REFLOW_CACHE_LINES;
+        c->count--;
+      }
+      ReflowLine& line = c->lines[(c->head + c->count) % REFLOW_CACHE_LINES];
+      line.first = openFirst;
+      line.pos = c->tailPos;
+      c->count++;
+      c->coverEnd = scrollbackEndLine();
+      c->coverEndPos = c->tailPos + height;
+    }
+    c->tailPos += height;
+  }
+  openFirst = scrollbackEndLine();
+  openLength = 0;
+}
+
+bool reflowPopRow() {
+  uint32_t end = scrollbackEndLine();
+  if (end <= scrollbackFirstRamLine()) return false;
+  int length;
+  bool wrapped;
+  if (!scrollbackGetLineInfo(end - 1, &length, &wrapped)) return false;
+  
+  if (openFirst == end) {
+    // The newest finished line opens again
+    uint32_t first, total;
+    bool wrapEnd;
+    if (!lineEndingAt(end - 1, scrollbackFirstRamLine(), &first, &total, &wrapEnd)) return false;
+    for (int f = 0; f < CELL_FONT_COUNT; f++) {
+      ReflowCache* c = &caches[f];
+      c->tailPos -= lineHeight(total, wrapEnd, c->cols);
+      
+      // Cached lines from it on are gone
+      while (c->count > 0 && c->lines[(c->head + c->count - 1) % REFLOW_CACHE_LINES].first >= first) {
+        c->count--;
+      }
+      if (c->coverEnd > first) {
+        c->coverEnd = first;
+        c->coverEndPos = c->tailPos;
+      }
+    }
+    openFirst = first;
+    openLength = total;
+  }
+  
+  scrollbackPopLine();
+  openLength -= length;
+  return true;
+}
+
+uint32_t reflowRowCount() {
+  prune();
+  int32_t rows = endPos() - frontPos() + (int32_t)(frontRow() - scrollbackFirstLine());
+  return rows > 0 ? rows : 0;
+}
+
+bool reflowGetRow(uint32_t depth, TermCell* cells, int count) {
+  int32_t pos = endPos() - (int32_t)depth;
+  uint32_t first, end;
+  int32_t linePos;
+  if (!locate(pos, &first, &end, &linePos)) return false;
+  return copySegment(first, end, pos - linePos, cells, count);
+}
+
+bool reflowFindRow(uint32_t line, int x, uint32_t* depth, int* column) {
+  prune();
+  if (line < scrollbackFirstLine() || line >= scrollbackEndLine()) return false;
+  
+  uint32_t first = openFirst;
+  int32_t pos = cache->tailPos;
+  if (line < openFirst) {
+    // Get the line's logical line into the window
+    if (line >= cache->coverEnd) {
+      if (cache->count == 0 || openFirst - line < line - cache->coverEnd) resetCover(cache);
+      while (line >= cache->coverEnd) {
+        if (stepForward() <= 0) return false;
+      }
+    }
+    while (frontRow() > line) {
+      if (stepBack() <= 0) return false;
+    }
+    int i = findCached(line, true);
+    first = cachedLine(i).first;
+    pos = cachedLine(i).pos;
+  }
+  
+  uint32_t offset;
+  if (!lineOffset(first, line, &offset)) return false;
+  offset += x;
+  *depth = endPos() - (pos + (int32_t)(offset / cache->cols));
+  *column = offset % cache->cols;
+  return true;
+}
+
+int reflowTakeRows(TermCell (*rows)[TERMINAL_MAX_COLS], bool* wrapped, int count, ReflowMark* marks, int markCount) {
+  int cols = cache->cols;
+  for (int m = 0; m < markCount; m++) marks[m].row = -1;
+  
+  // Fill rows from the bottom, one logical line at a time
+  int top = count;
+  while (top > 0) {
+    uint32_t end = scrollbackEndLine();
+    if (end <= scrollbackFirstRamLine()) break;
+    uint32_t first, length;
+    bool wrapEnd;
+    if (!lineEndingAt(end - 1, scrollbackFirstRamLine(), &first, &length, &wrapEnd)) break;
+    
+    // Marks on this line must stay on it, their x becomes the offset in it
+    int32_t height = lineHeight(length, wrapEnd, cols);
+    for (int m = 0; m < markCount; m++) {
+      if (marks[m].line < first || marks[m].line >= end) continue;
+      uint32_t offset;
+      lineOffset(first, marks[m].line, &offset);
+      marks[m].x += offset;
+      if (marks[m].x / cols + 1 > height) height = marks[m].x / cols + 1;
+    }
+    
+    // Leading rows that don't fit stay in scrollback
+    int32_t kept = height > top ? height - top : 0;
+    top -= height - kept;
+    for (int32_t seg = kept; seg < height; seg++) {
+      TermCell* row = rows[top + seg - kept];
+      copySegment(first, end, seg, row, cols);
+      for (int x = cols; x < TERMINAL_MAX_COLS; x++) {
+        row[x].glyph = ' ';
+        row[x].colors = CELL_DEFAULT_COLORS;
+      }
+      wrapped[top + seg - kept] = seg < height - 1;
+    }
+    for (int m = 0; m < markCount; m++) {
+      if (marks[m].line < first || marks[m].line >= end) continue;
+      int32_t seg = marks[m].x / cols;
+      if (seg < kept) continue;
+      marks[m].row = top + seg - kept;
+      marks[m].x %= cols;
+    }
+    
+    if (kept == 0) {
+      while (scrollbackEndLine() > first) reflowPopRow();
+      continue;
+    }
+    
+    // The kept rows end at a row boundary of the new width: a stored row
+    // across it is split, its head goes back soft-wrapped. Rows from the
+    // boundary on (an empty row wrapped onto too) are taken.
+    uint32_t split = kept * cols;
+    uint32_t row = first;
+    uint32_t offset = 0;
+    int rowLength = 0;
+    bool rowWrapped;
+    for (; row < end; row++) {
+      if (offset == split) break;
+      scrollbackGetLineInfo(row, &rowLength, &rowWrapped);
+      if (offset + rowLength > split) break;
+      offset += rowLength;
+    }
+    TermCell head[TERMINAL_MAX_COLS];
+    int headLength = split - offset;
+    if (row < end && headLength > 0) scrollbackGetLine(row, head, TERMINAL_MAX_COLS);
+    while (scrollbackEndLine() > row) reflowPopRow();
+    if (row < end && headLength > 0) reflowPushRow(head, headLength, true);
+    break;
+  }
+  return count - top;
+}
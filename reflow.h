@@ -0,0 +1,60 @@
+/*
+ * reflow.h - Scrollback rows wrapped to the current grid width
+ *
+ * Scrollback keeps every row the way it was written, with a flag on rows
+ * that were soft-wrapped into the next one at the right margin. Rows joined
+ * by soft wraps form a logical line. When the grid width changes, history
+ * is not rewritten: only the logical lines that are shown get their row
+ * breaks recomputed for the new width, and the result is cached per cell
+ * font, so switching back and forth costs the same however long the
+ * history is.
+ *
+ * Rows of the history at the current width are addressed by depth: depth 1
+ * is the row right above the live screen. All pushes and pops of scrollback
+ * rows go through this module so it can keep the depths of every width.
+ */
+
+#ifndef REFLOW_H
+#define REFLOW_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "termcell.h"
+
+// A place in the rows taken by reflowTakeRows(): a scrollback line and
+// column in, the taken row and column out (row -1 if it stayed in history)
+struct ReflowMark {
+  uint32_t line;
+  int x;
+  int row;
+};
+
+// Forget all rows (call with scrollbackClear())
+void reflowClear();
+
+// Width the history is shown at: the grid of a cell font (CELL_FONT_*)
+void reflowSetFont(int font);
+
+// Move a row to scrollback (see scrollbackPushLine) and drop the newest one
+void reflowPushRow(const TermCell* cells, int count, bool wrapped);
+bool reflowPopRow();
+
+// Rows of the history at the current width. Lines that were never shown
+// since the width changed count one row per stored row until they are.
+uint32_t reflowRowCount();
+
+// Cells of the history row at a depth, padded with blanks. Returns false if
+// the row isn't held, or its scrollback page is still being read from SD.
+bool reflowGetRow(uint32_t depth, TermCell* cells, int count);
+
+// Depth and column where a scrollback line's column x is shown. Returns
+// false like reflowGetRow.
+bool reflowFindRow(uint32_t line, int x, uint32_t* depth, int* column);
+
+// Take the newest history rows at the current width out of scrollback into
+// rows [count - n, count), n being the return value. A logical line that
+// doesn't fit leaves its leading rows in scrollback. Marks on the taken
+// lines get their new position, a marked line gets rows down to its mark.
+int reflowTakeRows(TermCell (*rows)[TERMINAL_MAX_COLS], bool* wrapped, int count, ReflowMark* marks, int markCount);
+
+#endif
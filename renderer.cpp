@@ -0,0 +1,491 @@
+/*
+ * renderer.cpp - Row rasterizer implementation
+ *
+ * Two row buffers are used ping-pong: while one streams to the panel over
+ * DMA the next row is rasterized into the other one, so the CPU only waits
+ * when rasterizing is faster than the SPI transfer.
+ *
+ * Glyphs are not expanded per cell: a set-associative LRU cache keeps the
+ * ready-to-push RGB565 tiles of recently drawn glyph/color combinations in
+ * the current cell font, so drawing a cell is a copy of its tile rows into
+ * the row buffer.
+ *
+ * Box drawing and block elements skip the cache: they are a few filled
+ * rectangles (glyphshapes.h) written straight into the row buffer.
+ *
+ * Cells are taken in runs that share colors and attributes, so the colors
+ * are resolved once per run, and stretches of blanks in a run are filled
+ * with the background without a tile lookup.
+ *
+ * With RENDER_FRAMEBUFFER the text area is kept in a 4bpp framebuffer of
+ * palette indices. Cells and fills only write into it and mark 8x8 tiles
+ * dirty; rendererEndFrame() expands the dirty tiles through the palette
+ * and pushes each run of adjacent dirty tiles as one window.
+ */
+
+#include "renderer.h"
+#include "display.h"
+#include "utf8.h"
+#include "glyphshapes.h"
+
+// ANSI palette: normal colors, then bright colors (bold / SGR 90-97)
+const uint16_t terminalPalette[16] = {
+  TFT_BLACK, TFT_RED, TFT_GREEN, TFT_YELLOW, TFT_BLUE, TFT_MAGENTA, TFT_CYAN, TFT_WHITE,
+  TFT_DARKGREY, 0xFC10, 0x87F0, 0xFFF0, 0x841F, 0xFC1F, 0x87FF, 0xFFFF
+};
+
+// Text row buffers, colors stored byte-swapped (panel order)
+// so the buffers can be pushed without swapping. Word aligned, a cell
+// starts on a 4-byte boundary (cells are an even number of pixels wide).
+static uint16_t lineBuffers[2][SCREEN_WIDTH * 8] __attribute__((aligned(4)));
+static int nextBuffer = 0;
+
+// Current cell font and its cell size
+static int cellFont = CELL_FONT_6X8;
+static int cellWidth = 6;
+static int cellHeight = 8;
+
+static bool dmaEnabled = false;
+static bool savedSwapBytes = false;
+
+// Glyph tile cache. The key packs font index, underline and the resolved
+// fg/bg palette indices (bold and inverse applied), GLYPH_KEY_VALID marks
+// a used slot. Each set is searched linearly and evicts its least
+// recently used tile.
+#define GLYPH_CACHE_SETS (GLYPH_CACHE_ENTRIES / GLYPH_CACHE_WAYS)
+#define GLYPH_KEY_VALID 0x80000000u
+
+#if GLYPH_CACHE_SETS & (GLYPH_CACHE_SETS - 1)
+#error "GLYPH_CACHE_ENTRIES / GLYPH_CACHE_WAYS must be a power of two"
+#endif
+
+struct GlyphTile {
+  uint32_t key;
+  uint32_t used;           // LRU stamp
+  uint16_t pixels[8 * 6];  // Row-major, panel byte order, largest cell font
+};
+
+static GlyphTile glyphCache[GLYPH_CACHE_SETS][GLYPH_CACHE_WAYS];
+static uint32_t glyphClock = 0;
+
+#if RENDER_FRAMEBUFFER
+// Text area framebuffer: palette indices, two pixels a byte (left pixel in
+// the high nibble). Dirty tiles are kept per row of tiles as a mask of tile
+// columns plus the scanlines written in that row.
+#define FB_HEIGHT (SCREEN_HEIGHT - TERMINAL_START_Y)
+#define FB_TILE_COLS (SCREEN_WIDTH / 8)
+#define FB_TILE_ROWS ((FB_HEIGHT + 7) / 8)
+
+static_assert(FB_TILE_COLS <= 64, "Tile columns must fit the dirty mask");
+
+static uint8_t frameBuffer[FB_HEIGHT][SCREEN_WIDTH / 2];
+static uint64_t tileMask[FB_TILE_ROWS];
+static uint8_t tileTop[FB_TILE_ROWS];
+static uint8_t tileBottom[FB_TILE_ROWS];
+
+// Panel colors of a framebuffer byte, as the two pixels of a buffer word
+static uint32_t pairColors[256];
+#endif
+
+// Statistics
+static RendererStats stats;
+static unsigned long frameStart = 0;
+
+// Wait for the transfer in flight and count the time as blocked
+static void waitForTransfer() {
+  if (!dmaEnabled || !tft.dmaBusy()) return;
+  unsigned long start = micros();
+  tft.dmaWait();
+  stats.blockedUs += micros() - start;
+}
+
+// Palette color in panel byte order
+static inline uint16_t panelColor(uint8_t index) {
+  uint16_t color = terminalPalette[index];
+  return (color >> 8) | (color << 8);
+}
+
+void rendererInit() {
+#if RENDER_USE_DMA
+  if (!dmaEnabled) {
+    dmaEnabled = tft.initDMA();
+  }
+#endif
+#if RENDER_FRAMEBUFFER
+  for (int pair = 0; pair < 256; pair++) {
+    pairColors[pair] = panelColor(pair >> 4) | (uint32_t)panelColor(pair & 0x0F) << 16;
+  }
+#endif
+}
+
+// Push w x h pixels of a row buffer as a window at (x, y). With DMA the
+// other buffer is rasterized into while this one streams out.
+static void pushWindow(uint16_t* buffer, int x, int y, int w, int h) {
+  // Previous window must be out before the next one can be set
+  waitForTransfer();
+  
+  tft.setAddrWindow(x, y, w, h);
+  if (dmaEnabled) {
+    tft.pushPixelsDMA(buffer, w * h);
+  } else {
+    // Blocking push, all of it is time spent waiting on SPI
+    unsigned long start = micros();
+    tft.pushPixels(buffer, w * h);
+    stats.blockedUs += micros() - start;
+  }
+  nextBuffer ^= 1;
+  
+  stats.pixels += w * h;
+}
+
+#if RENDER_FRAMEBUFFER
+// True if a rectangle lies in the framebuffer
+static bool inFrameBuffer(int x, int y, int w, int h) {
+  return w > 0 && h > 0 && x >= 0 && x + w <= SCREEN_WIDTH &&
+         y >= TERMINAL_START_Y && y + h <= SCREEN_HEIGHT;
+}
+
+// Note pixels [x, x + w) of framebuffer scanlines [y, y + h) as changed
+static void markTiles(int x, int y, int w, int h) {
+  uint64_t columns = ((uint64_t)2 << ((x + w - 1) / 8)) - ((uint64_t)1 << (x / 8));
+  for (int row = y / 8; row <= (y + h - 1) / 8; row++) {
+    int top = y > row * 8 ? y - row * 8 : 0;
+    int bottom = y + h < row * 8 + 8 ? y + h - row * 8 : 8;
+    if (tileMask[row] == 0 || top < tileTop[row]) tileTop[row] = top;
+    if (tileMask[row] == 0 || bottom > tileBottom[row]) tileBottom[row] = bottom;
+    tileMask[row] |= columns;
+  }
+}
+
+// Fill a rectangle of the framebuffer (framebuffer scanlines) with a
+// palette index
+static void fillFrameBuffer(int x, int y, int w, int h, uint8_t index) {
+  for (int line = y; line < y + h; line++) {
+    uint8_t* bytes = frameBuffer[line];
+    int from = x;
+    int to = x + w;
+    if (from & 1) {
+      bytes[from / 2] = (bytes[from / 2] & 0xF0) | index;
+      from++;
+    }
+    if ((to & 1) && to > from) {
+      to--;
+      bytes[to / 2] = (bytes[to / 2] & 0x0F) | index << 4;
+    }
+    memset(bytes + from / 2, index << 4 | index, (to - from) / 2);
+  }
+}
+
+// Push the dirty tiles: each row of tiles as runs of adjacent dirty tiles,
+// one window per run over the scanlines written in that row
+static void flushFrameBuffer() {
+  for (int row = 0; row < FB_TILE_ROWS; row++) {
+    uint64_t mask = tileMask[row];
+    if (mask == 0) continue;
+    tileMask[row] = 0;
+    int top = row * 8 + tileTop[row];
+    int height = tileBottom[row] - tileTop[row];
+    
+    int column = 0;
+    while (mask != 0) {
+      while (!(mask & 1)) {
+        mask >>= 1;
+        column++;
+      }
+      int first = column;
+      while (mask & 1) {
+        mask >>= 1;
+        column++;
+      }
+      
+      // Expand the run through the palette, two pixels at a time
+      int x = first * 8;
+      int width = (column - first) * 8;
+      uint16_t* buffer = lineBuffers[nextBuffer];
+      uint32_t* words = (uint32_t*)buffer;
+      for (int line = top; line < top + height; line++) {
+        const uint8_t* bytes = &frameBuffer[line][x / 2];
+        for (int i = 0; i < width / 2; i++) *words++ = pairColors[bytes[i]];
+      }
+      pushWindow(buffer, x, TERMINAL_START_Y + top, width, height);
+      stats.tiles += column - first;
+    }
+  }
+}
+#endif
+
+void rendererBeginFrame() {
+  frameStart = micros();
+  savedSwapBytes = tft.getSwapBytes();
+  tft.setSwapBytes(false);
+  tft.startWrite();
+}
+
+void rendererEndFrame() {
+#if RENDER_FRAMEBUFFER
+  flushFrameBuffer();
+#endif
+  
+  // Status bar and keyboard drawing share the bus, so the last row
+  // has to be out before the frame ends
+  waitForTransfer();
+  tft.endWrite();
+  tft.setSwapBytes(savedSwapBytes);
+  stats.frameUs += micros() - frameStart;
+}
+
+// How the cells of a run are drawn: palette indices and colors in panel
+// byte order (bold is shown as the bright color, inverse swaps foreground
+// and background) and the tile key and set hash bits besides the glyph
+struct CellStyle {
+  uint8_t fgIndex;
+  uint8_t bgIndex;
+  uint16_t fg;
+  uint16_t bg;
+  bool underline;
+  uint32_t key;
+  uint8_t setHash;
+};
+
+static void cellStyle(const TermCell& cell, CellStyle* style) {
+  uint8_t fgIndex = cellFg(cell);
+  if (cell.glyph & CELL_BOLD) fgIndex |= 8;
+  uint8_t bgIndex = cellBg(cell);
+  if (cell.glyph & CELL_INVERSE) {
+    uint8_t swap = fgIndex;
+    fgIndex = bgIndex;
+    bgIndex = swap;
+  }
+  style->fgIndex = fgIndex;
+  style->bgIndex = bgIndex;
+  style->fg = panelColor(fgIndex);
+  style->bg = panelColor(bgIndex);
+  style->underline = cell.glyph & CELL_UNDERLINE;
+  style->key = GLYPH_KEY_VALID | (style->underline ? 0x100 : 0) | fgIndex << 4 | bgIndex;
+  style->setHash = fgIndex * 5 ^ bgIndex * 3;
+}
+
+// Cached tile of a glyph in a style, rasterized on a miss
+static const uint16_t* glyphTile(uint16_t fontIndex, const CellStyle& style) {
+  uint32_t key = style.key | (uint32_t)fontIndex << 9;
+  
+  GlyphTile* set = glyphCache[(fontIndex ^ style.setHash) & (GLYPH_CACHE_SETS - 1)];
+  GlyphTile* victim = &set[0];
+  for (int way = 0; way < GLYPH_CACHE_WAYS; way++) {
+    if (set[way].key == key) {
+      set[way].used = ++glyphClock;
+      stats.glyphHits++;
+      return set[way].pixels;
+    }
+    if (set[way].used < victim->used) victim = &set[way];
+  }
+  stats.glyphMisses++;
+  
+  // Expand the bitmap into the least recently used slot
+  uint8_t columns[6];
+  getCellGlyphColumns(cellFont, fontIndex, columns);
+  if (style.underline) {
+    for (int col = 0; col < cellWidth; col++) columns[col] |= 1 << (cellHeight - 1);
+  }
+  uint16_t fg = style.fg;
+  uint16_t bg = style.bg;
+  uint16_t* pixel = victim->pixels;
+  for (int row = 0; row < cellHeight; row++) {
+    for (int col = 0; col < cellWidth; col++) {
+      *pixel++ = (columns[col] & (1 << row)) ? fg : bg;
+    }
+  }
+  victim->key = key;
+  victim->used = ++glyphClock;
+  return victim->pixels;
+}
+
+// Fill rowCount rows of width pixels at pixel with a color, the buffer
+// being stride pixels wide (pixel word aligned, width even)
+static void fillPixels(uint16_t* pixel, int width, int stride, int rowCount, uint16_t color) {
+  uint32_t color2 = color | (uint32_t)color << 16;
+  for (int y = 0; y < rowCount; y++) {
+    uint32_t* words = (uint32_t*)pixel;
+    for (int x = 0; x < width / 2; x++) words[x] = color2;
+    pixel += stride;
+  }
+}
+
+// Draw rows firstRow..firstRow+rowCount-1 of a box drawing or block
+// element cell at pixel, the buffer being stride pixels wide
+static void drawShapeCell(uint16_t fontIndex, const CellStyle& style, uint16_t* pixel, int stride, int firstRow, int rowCount) {
+  uint16_t fg = style.fg;
+  fillPixels(pixel, cellWidth, stride, rowCount, style.bg);
+  
+  // Rectangles clipped to the rows being drawn
+  int endRow = firstRow + rowCount;
+  int shape = fontIndex - GLYPH_SHAPE_FIRST;
+  uint16_t* row;
+  const GlyphShapeFont& shapes = glyphShapeFonts[cellFont];
+  const GlyphRect* rect = &shapes.rects[shapes.start[shape]];
+  const GlyphRect* end = &shapes.rects[shapes.start[shape + 1]];
+  for (; rect < end; rect++) {
+    int top = rect->y > firstRow ? rect->y : firstRow;
+    int bottom = rect->y + rect->h < endRow ? rect->y + rect->h : endRow;
+    row = pixel + (top - firstRow) * stride;
+    for (int y = top; y < bottom; y++) {
+      if (rect->pattern == 0xF) {
+        for (int x = rect->x; x < rect->x + rect->w; x++) row[x] = fg;
+      } else {
+        // Shade: every other pixel of the rows the pattern selects
+        uint8_t bits = rect->pattern >> ((y & 1) * 2);
+        for (int x = rect->x; x < rect->x + rect->w; x++) {
+          if (bits & (1 << (x & 1))) row[x] = fg;
+        }
+      }
+      row += stride;
+    }
+  }
+  
+  int underlineRow = cellHeight - 1;
+  if (style.underline && firstRow <= underlineRow && underlineRow < endRow) {
+    row = pixel + (underlineRow - firstRow) * stride;
+    for (int x = 0; x < cellWidth; x++) row[x] = fg;
+  }
+  stats.shapeCells++;
+}
+
+void rendererDrawCells(const TermCell* cells, int count, int x, int y) {
+  rendererDrawCellRows(cells, count, x, y, 0, cellHeight);
+}
+
+void rendererDrawCellRows(const TermCell* cells, int count, int x, int y, int firstRow, int rowCount) {
+  if (count <= 0 || rowCount <= 0) return;
+  int width = count * cellWidth;
+  
+  // Rasterize into the buffer that is not streaming out
+  uint16_t* buffer = lineBuffers[nextBuffer];
+#if RENDER_FRAMEBUFFER
+  bool buffered = inFrameBuffer(x, y, width, rowCount);
+#endif
+  
+  int i = 0;
+  while (i < count) {
+    // Run of cells with the same colors and attributes
+    uint16_t attributes = cells[i].glyph & ~CELL_GLYPH_MASK;
+    int end = i + 1;
+    while (end < count && cells[end].colors == cells[i].colors &&
+           (cells[end].glyph & ~CELL_GLYPH_MASK) == attributes) {
+      end++;
+    }
+    CellStyle style;
+    cellStyle(cells[i], &style);
+    stats.runs++;
+    int runStart = i;
+    
+    while (i < end) {
+      uint16_t* pixel = &buffer[i * cellWidth];
+      uint16_t fontIndex = cells[i].glyph & CELL_GLYPH_MASK;
+      
+      // Blanks are background only, a stretch of them is one fill
+      if (fontIndex == ' ' && !style.underline) {
+        int blanks = 1;
+        while (i + blanks < end && (cells[i + blanks].glyph & CELL_GLYPH_MASK) == ' ') blanks++;
+        fillPixels(pixel, blanks * cellWidth, width, rowCount, style.bg);
+        stats.blankCells += blanks;
+        i += blanks;
+        continue;
+      }
+      
+      if ((uint16_t)(fontIndex - GLYPH_SHAPE_FIRST) < GLYPH_SHAPE_COUNT) {
+        drawShapeCell(fontIndex, style, pixel, width, firstRow, rowCount);
+        i++;
+        continue;
+      }
+      
+      const uint16_t* tile = glyphTile(fontIndex, style) + firstRow * cellWidth;
+      for (int row = 0; row < rowCount; row++) {
+        memcpy(pixel, tile, cellWidth * sizeof(uint16_t));
+        tile += cellWidth;
+        pixel += width;
+      }
+      i++;
+    }
+    
+#if RENDER_FRAMEBUFFER
+    // Every pixel of the run is its foreground or its background
+    if (buffered) {
+      const uint16_t* pixel = &buffer[runStart * cellWidth];
+      for (int row = 0; row < rowCount; row++) {
+        uint8_t* bytes = &frameBuffer[y - TERMINAL_START_Y + row][(x + runStart * cellWidth) / 2];
+        for (int p = 0; p < (end - runStart) * cellWidth; p += 2) {
+          uint8_t left = pixel[p] == style.fg ? style.fgIndex : style.bgIndex;
+          uint8_t right = pixel[p + 1] == style.fg ? style.fgIndex : style.bgIndex;
+          *bytes++ = left << 4 | right;
+        }
+        pixel += width;
+      }
+    }
+#else
+    (void)runStart;
+#endif
+  }
+  
+#if RENDER_FRAMEBUFFER
+  if (buffered) {
+    markTiles(x, y - TERMINAL_START_Y, width, rowCount);
+    return;
+  }
+#endif
+  pushWindow(buffer, x, y, width, rowCount);
+  stats.rows++;
+}
+
+void rendererSetFont(int font) {
+  cellFont = font;
+  cellWidth = cellFontWidth(font);
+  cellHeight = cellFontHeight(font);
+  
+  // Tiles of the previous font are a different size
+  memset(glyphCache, 0, sizeof(glyphCache));
+  glyphClock = 0;
+}
+
+void rendererFillRect(int x, int y, int w, int h, uint16_t color) {
+#if RENDER_FRAMEBUFFER
+  // Palette colors in the text area only go to the framebuffer
+  for (int index = 0; index < 16; index++) {
+    if (terminalPalette[index] == color && inFrameBuffer(x, y, w, h)) {
+      fillFrameBuffer(x, y - TERMINAL_START_Y, w, h, index);
+      markTiles(x, y - TERMINAL_START_Y, w, h);
+      return;
+    }
+  }
+#endif
+  waitForTransfer();
+  tft.fillRect(x, y, w, h, color);
+}
+
+void rendererSetGlass(int x, int y, int w, int h, uint16_t color) {
+#if RENDER_FRAMEBUFFER
+  for (int index = 0; index < 16; index++) {
+    if (terminalPalette[index] == color && inFrameBuffer(x, y, w, h)) {
+      fillFrameBuffer(x, y - TERMINAL_START_Y, w, h, index);
+      return;
+    }
+  }
+#else
+  (void)x;
+  (void)y;
+  (void)w;
+  (void)h;
+  (void)color;
+#endif
+}
+
+bool rendererUsesDMA() {
+  return dmaEnabled;
+}
+
+void rendererGetStats(RendererStats* out) {
+  *out = stats;
+}
+
+void rendererResetStats() {
+  memset(&stats, 0, sizeof(stats));
+}
@@ -0,0 +1,64 @@
+/*
+ * renderer.h - Row rasterizer for the terminal text area
+ *
+ * A span of character cells is rasterized into an RGB565 line buffer and
+ * sent to the display with one setAddrWindow + pushPixels (double-buffered
+ * DMA on ESP32), instead of one tft.print() or 48 fillRect() calls per
+ * character.
+ */
+
+#ifndef RENDERER_H
+#define RENDERER_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "termcell.h"
+
+// Renderer statistics
+struct RendererStats {
+  uint32_t rows;       // Row windows pushed (framebuffer tiles count in tiles)
+  uint32_t pixels;     // Pixels pushed in row windows and tile runs
+  uint32_t blockedUs;  // Time the CPU waited on SPI (DMA wait or blocking push)
+  uint32_t frameUs;    // Time spent between rendererBeginFrame() and rendererEndFrame()
+  uint32_t glyphHits;    // Cells drawn from a cached glyph tile
+  uint32_t glyphMisses;  // Cells whose tile had to be rasterized
+  uint32_t shapeCells;   // Box drawing / block element cells drawn as rectangles
+  uint32_t runs;         // Runs of cells sharing colors and attributes (one color lookup each)
+  uint32_t blankCells;   // Blank cells filled with the background, no tile lookup
+  uint32_t tiles;        // Dirty 8x8 framebuffer tiles pushed (RENDER_FRAMEBUFFER)
+};
+
+// Initialize renderer (enables DMA when RENDER_USE_DMA is set)
+void rendererInit();
+
+// Bracket all renderer drawing of one frame
+void rendererBeginFrame();
+void rendererEndFrame();
+
+// Rasterize count cells and push them as one window of count cells at (x, y).
+// With DMA the call returns while the row is still streaming out.
+void rendererDrawCells(const TermCell* cells, int count, int x, int y);
+
+// Same for glyph rows [firstRow, firstRow + rowCount) only, pushed as a
+// window rowCount pixels high at (x, y) - for rows cut off by a pixel scroll
+void rendererDrawCellRows(const TermCell* cells, int count, int x, int y, int firstRow, int rowCount);
+
+// Draw cells in a cell font (CELL_FONT_*), drops the cached glyph tiles
+void rendererSetFont(int font);
+
+// fillRect that waits for a row transfer in flight first. With
+// RENDER_FRAMEBUFFER palette colors in the text area go to the framebuffer.
+void rendererFillRect(int x, int y, int w, int h, uint16_t color);
+
+// Tell the framebuffer that a rectangle was filled on the panel by other
+// drawing (the keyboard closing). No-op without RENDER_FRAMEBUFFER.
+void rendererSetGlass(int x, int y, int w, int h, uint16_t color);
+
+// True if rows are pushed with DMA
+bool rendererUsesDMA();
+
+// Statistics
+void rendererGetStats(RendererStats* stats);
+void rendererResetStats();
+
+#endif
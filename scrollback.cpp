@@ -0,0 +1,606 @@
+/*
+ * scrollback.cpp - Compressed scrollback store implementation
+ *
+ * Line record in the arena (contiguous, never split at the arena end):
+ *   [text length][wrap flag | run count][bloom][UTF-8 text][runs: cell count, colors, attributes]
+ * Trailing blanks are not stored, except in soft-wrapped rows whose full
+ * width counts when they are joined with the next row. A line in default colors without
+ * attributes has no runs, so plain log output costs 2 bytes + its text.
+ * Lines of 3 or more text bytes carry a 64-bit bloom filter of their
+ * case-folded character trigrams, so search can skip a line without
+ * decoding it. Shorter lines have no trigrams and no bloom.
+ *
+ * With SCROLLBACK_SPILL and an SD card, evicted records are packed into
+ * fixed-size pages that are appended to a spill file (itself a ring of
+ * SCROLLBACK_SPILL_PAGES pages). RAM keeps only the first line number of
+ * each page. A spill task owns the file: it writes full pages and reads
+ * pages back into a small LRU cache on request, so neither the parser nor
+ * scrolling ever waits for the card. Lines whose page is not cached yet
+ * read as missing until it arrives; neighbouring pages are read ahead.
+ */
+
+#include "scrollback.h"
+#include "utf8.h"
+#include "sdcard.h"
+#include <atomic>
+
+#if SCROLLBACK_SPILL
+#include <SD.h>
+#include "freertos/queue.h"
+#endif
+
+#if SCROLLBACK_ARENA_SIZE > 65536
+#error "SCROLLBACK_ARENA_SIZE must fit 16-bit line offsets"
+#endif
+
+#define RECORD_HEADER 2
+#define RECORD_WRAPPED 0x80     // In the run count byte: row continues in the next line
+#define RECORD_RUNS_MASK 0x7F
+#define RUN_SIZE 3
+#define BLOOM_SIZE 8
+
+// Arena - records are appended at arenaHead and wrap to offset 0 when
+// they don't fit before the end
+static uint8_t arena[SCROLLBACK_ARENA_SIZE];
+static uint32_t arenaHead = 0;
+
+// Arena offset of each held line, indexed by line number
+static uint16_t lineOffset[SCROLLBACK_MAX_LINES];
+static uint32_t firstLine = 0;
+static uint32_t endLine = 0;
+
+static uint32_t bytesUsed = 0;
+static uint32_t evictedLines = 0;
+
+#if SCROLLBACK_SPILL
+
+// Page buffer states
+enum PageState : uint8_t {
+  PAGE_FREE,     // Not in use
+  PAGE_BUSY,     // Owned by the spill task (being read or written)
+  PAGE_READY,    // Holds a valid page
+  PAGE_FAILED    // Could not be read back, its lines read as not held
+};
+
+// Write buffers - one is filled with evicted records while the other may
+// be written out by the spill task
+static uint8_t fillBuffers[2][SCROLLBACK_PAGE_SIZE];
+static std::atomic<uint8_t> fillState[2];
+static uint32_t fillPage[2];
+static int fillIndex = 0;
+static uint32_t fillUsed = 0;
+static uint32_t fillFirstLine = 0;
+
+// First line of each page in the spill file, indexed by page number.
+// Pages [spillFirstPage, spillEndPage) are on the card or being written.
+static uint32_t pageFirstLine[SCROLLBACK_SPILL_PAGES];
+static uint32_t spillFirstPage = 0;
+static uint32_t spillEndPage = 0;
+static uint32_t spillFirstLine = 0;  // Oldest line on the card or in fill buffers
+
+// Read cache
+static uint8_t cacheBuffers[SCROLLBACK_CACHE_PAGES][SCROLLBACK_PAGE_SIZE];
+static std::atomic<uint8_t> cacheState[SCROLLBACK_CACHE_PAGES];
+static uint32_t cachePage[SCROLLBACK_CACHE_PAGES];
+static uint32_t cacheUsed[SCROLLBACK_CACHE_PAGES];  // LRU stamp
+static uint32_t cacheClock = 0;
+
+// Spill task
+struct SpillRequest {
+  uint8_t* buffer;
+  std::atomic<uint8_t>* state;
+  uint32_t page;
+  bool write;
+};
+
+static TaskHandle_t spillTaskHandle = nullptr;
+static QueueHandle_t spillQueue = nullptr;
+static std::atomic<bool> spillReady(false);
+static std::atomic<bool> spillFailed(false);
+static std::atomic<uint32_t> pageLoads(0);
+static File spillFile;
+
+// File slots whose last write came up short (written by the spill task only)
+static bool slotFailed[SCROLLBACK_SPILL_PAGES];
+
+static uint32_t cacheHits = 0;
+static uint32_t cacheMisses = 0;
+
+#endif
+
+static uint32_t bloomSize(uint32_t textLen) {
+  return textLen >= 3 ? BLOOM_SIZE : 0;
+}
+
+static uint32_t recordSize(const uint8_t* record) {
+  return RECORD_HEADER + bloomSize(record[0]) + record[0] + (record[1] & RECORD_RUNS_MASK) * RUN_SIZE;
+}
+
+// Bloom filter bit of one trigram of case-folded font indices
+static uint64_t trigramBit(uint16_t a, uint16_t b, uint16_t c) {
+  uint32_t hash = ((uint32_t)a << 16 ^ (uint32_t)b << 8 ^ c) * 0x9E3779B1u;
+  return 1ULL << (hash >> 26);
+}
+
+uint64_t scrollbackTrigramBloom(const uint16_t* glyphs, int count) {
+  uint64_t bloom = 0;
+  for (int i = 0; i + 2 < count; i++) {
+    bloom |= trigramBit(glyphs[i], glyphs[i + 1], glyphs[i + 2]);
+  }
+  return bloom;
+}
+
+#if SCROLLBACK_SPILL
+
+static void spillTask(void* param) {
+  // The task owns the spill file, the card itself is shared with session
+  // logging in loop() under sdLock()
+  sdLock();
+  spillFile = SD.open(SCROLLBACK_SPILL_FILE, "w+");
+  sdUnlock();
+  if (!spillFile) {
+    // History past the arena is dropped, as without a card
+    spillFailed = true;
+    sdReportError();
+    vTaskDelete(nullptr);
+    return;
+  }
+  spillReady = true;
+  
+  SpillRequest request;
+  for (;;) {
+    if (xQueueReceive(spillQueue, &request, portMAX_DELAY) != pdTRUE) continue;
+    
+    uint32_t slot = request.page % SCROLLBACK_SPILL_PAGES;
+    sdLock();
+    bool seeked = spillFile.seek(slot * SCROLLBACK_PAGE_SIZE);
+    if (request.write) {
+      // A slot that wasn't written in full is never read back
+      size_t written = seeked ? spillFile.write(request.buffer, SCROLLBACK_PAGE_SIZE) : 0;
+      spillFile.flush();
+      slotFailed[slot] = written != SCROLLBACK_PAGE_SIZE;
+      sdUnlock();
+      request.state->store(PAGE_FREE, std::memory_order_release);
+    } else {
+      bool ok = seeked && !slotFailed[slot] &&
+                spillFile.read(request.buffer, SCROLLBACK_PAGE_SIZE) == SCROLLBACK_PAGE_SIZE;
+      sdUnlock();
+      request.state->store(ok ? PAGE_READY : PAGE_FAILED, std::memory_order_release);
+      pageLoads.fetch_add(1, std::memory_order_release);
+    }
+  }
+}
+
+static void spillRequest(uint8_t* buffer, std::atomic<uint8_t>* state, uint32_t page, bool write) {
+  SpillRequest request = {buffer, state, page, write};
+  state->store(PAGE_BUSY, std::memory_order_relaxed);
+  xQueueSend(spillQueue, &request, portMAX_DELAY);
+}
+
+// Wait until the spill task has finished all requests
+static void waitForSpillIdle() {
+  for (int i = 0; i < 2; i++) {
+    while (fillState[i].load(std::memory_order_acquire) == PAGE_BUSY) vTaskDelay(1);
+  }
+  for (int i = 0; i < SCROLLBACK_CACHE_PAGES; i++) {
+    while (cacheState[i].load(std::memory_order_acquire) == PAGE_BUSY) vTaskDelay(1);
+  }
+}
+
+// Hand the filled page to the spill task and start the next one
+static void spillFillPage() {
+  if (spillEndPage - spillFirstPage >= SCROLLBACK_SPILL_PAGES) {
+    // File ring is full - the oldest page gets overwritten
+    spillFirstPage++;
+    spillFirstLine = pageFirstLine[spillFirstPage % SCROLLBACK_SPILL_PAGES];
+  }
+  
+  uint32_t page = spillEndPage++;
+  pageFirstLine[page % SCROLLBACK_SPILL_PAGES] = fillFirstLine;
+  fillPage[fillIndex] = page;
+  memset(&fillBuffers[fillIndex][fillUsed], 0, SCROLLBACK_PAGE_SIZE - fillUsed);
+  spillRequest(fillBuffers[fillIndex], &fillState[fillIndex], page, true);
+  
+  // A cached copy of the overwritten file slot is stale now
+  for (int i = 0; i < SCROLLBACK_CACHE_PAGES; i++) {
+    uint8_t state = cacheState[i].load(std::memory_order_acquire);
+    if ((state == PAGE_READY || state == PAGE_FAILED) && cachePage[i] < spillFirstPage) {
+      cacheState[i] = PAGE_FREE;
+    }
+  }
+  
+  // Switch buffers, waiting for the card if it fell two pages behind
+  fillIndex ^= 1;
+  while (fillState[fillIndex].load(std::memory_order_acquire) == PAGE_BUSY) vTaskDelay(1);
+  fillUsed = 0;
+}
+
+// Append an evicted record to the page being filled
+static void spillRecord(const uint8_t* record, uint32_t line) {
+  uint32_t len = recordSize(record);
+  if (fillUsed + len > SCROLLBACK_PAGE_SIZE) spillFillPage();
+  if (fillUsed == 0) fillFirstLine = line;
+  memcpy(&fillBuffers[fillIndex][fillUsed], record, len);
+  fillUsed += len;
+}
+
+#endif
+
+void scrollbackInit() {
+#if SCROLLBACK_SPILL
+  // Spill only with a working card, the task is started once
+  if (spillTaskHandle != nullptr) return;
+  SDStatus status = sdGetStatus();
+  if (status != SD_READY && status != SD_RECORDING) return;
+  
+  spillQueue = xQueueCreate(SCROLLBACK_CACHE_PAGES + 2, sizeof(SpillRequest));
+  xTaskCreatePinnedToCore(spillTask, "scrollback_spill", SPILL_TASK_STACK_SIZE, nullptr,
+                          SPILL_TASK_PRIORITY, &spillTaskHandle, SPILL_TASK_CORE);
+#endif
+}
+
+static void evictOldest() {
+  const uint8_t* record = &arena[lineOffset[firstLine % SCROLLBACK_MAX_LINES]];
+#if SCROLLBACK_SPILL
+  if (spillReady) {
+    spillRecord(record, firstLine);
+  } else {
+    spillFirstLine = firstLine + 1;
+  }
+#endif
+  bytesUsed -= recordSize(record);
+  firstLine++;
+  evictedLines++;
+}
+
+void scrollbackClear() {
+  arenaHead = 0;
+  firstLine = 0;
+  endLine = 0;
+  bytesUsed = 0;
+  
+#if SCROLLBACK_SPILL
+  // Finish requests in flight before page numbers start over
+  waitForSpillIdle();
+  for (int i = 0; i < SCROLLBACK_CACHE_PAGES; i++) {
+    cacheState[i] = PAGE_FREE;
+  }
+  fillUsed = 0;
+  fillFirstLine = 0;
+  spillFirstPage = 0;
+  spillEndPage = 0;
+  spillFirstLine = 0;
+#endif
+}
+
+// True if [pos, pos + len) doesn't overlap any held record
+static bool regionFree(uint32_t pos, uint32_t len) {
+  if (firstLine == endLine) return true;
+  
+  uint32_t tail = lineOffset[firstLine % SCROLLBACK_MAX_LINES];
+  if (arenaHead > tail) {
+    // Records in [tail, arenaHead)
+    return pos >= arenaHead || pos + len <= tail;
+  }
+  // Wrapped: records in [tail, end of arena) and [0, arenaHead)
+  return pos >= arenaHead && pos + len <= tail;
+}
+
+void scrollbackPushLine(const TermCell* cells, int count, bool wrapped) {
+  // Trim trailing blanks
+  if (!wrapped) {
+    while (count > 0 && cellIsBlank(cells[count - 1])) count--;
+  }
+  
+  // Size the record: UTF-8 text and attribute runs
+  uint32_t textLen = 0;
+  uint32_t runCount = 0;
+  uint64_t bloom = 0;
+  for (int x = 0; x < count; x++) {
+    uint8_t utf8[4];
+    textLen += utf8Encode(fontIndexToUnicode(cells[x].glyph & CELL_GLYPH_MASK), utf8);
+    if (x >= 2) {
+      bloom |= trigramBit(fontIndexFoldCase(cells[x - 2].glyph & CELL_GLYPH_MASK),
+                          fontIndexFoldCase(cells[x - 1].glyph & CELL_GLYPH_MASK),
+                          fontIndexFoldCase(cells[x].glyph & CELL_GLYPH_MASK));
+    }
+    if (x == 0 || cells[x].colors != cells[x - 1].colors ||
+        (cells[x].glyph & ~CELL_GLYPH_MASK) != (cells[x - 1].glyph & ~CELL_GLYPH_MASK)) {
+      runCount++;
+    }
+  }
+  
+  // One run in default colors without attributes is implied
+  if (runCount == 1 && cells[0].colors == CELL_DEFAULT_COLORS &&
+      (cells[0].glyph & ~CELL_GLYPH_MASK) == 0) {
+    runCount = 0;
+  }
+  uint32_t len = RECORD_HEADER + bloomSize(textLen) + textLen + runCount * RUN_SIZE;
+  
+  // Make room: a free line slot and a free arena region
+  if (endLine - firstLine >= SCROLLBACK_MAX_LINES) evictOldest();
+  uint32_t pos;
+  for (;;) {
+    if (firstLine == endLine) arenaHead = 0;
+    pos = arenaHead;
+    if (pos + len > SCROLLBACK_ARENA_SIZE) pos = 0;
+    if (regionFree(pos, len)) break;
+    evictOldest();
+  }
+  
+  // Write the record
+  uint8_t* record = &arena[pos];
+  record[0] = textLen;
+  record[1] = runCount | (wrapped ? RECORD_WRAPPED : 0);
+  if (bloomSize(textLen) > 0) memcpy(record + RECORD_HEADER, &bloom, BLOOM_SIZE);
+  uint8_t* text = record + RECORD_HEADER + bloomSize(textLen);
+  for (int x = 0; x < count; x++) {
+    text += utf8Encode(fontIndexToUnicode(cells[x].glyph & CELL_GLYPH_MASK), text);
+  }
+  if (runCount > 0) {
+    uint8_t* run = text;
+    for (int x = 0; x < count; x++) {
+      if (x > 0 && cells[x].colors == cells[x - 1].colors &&
+          (cells[x].glyph & ~CELL_GLYPH_MASK) == (cells[x - 1].glyph & ~CELL_GLYPH_MASK)) {
+        run[-RUN_SIZE]++;
+        continue;
+      }
+      run[0] = 1;
+      run[1] = cells[x].colors;
+      run[2] = cells[x].glyph >> 12;
+      run += RUN_SIZE;
+    }
+  }
+  
+  lineOffset[endLine % SCROLLBACK_MAX_LINES] = pos;
+  endLine++;
+  arenaHead = pos + len;
+  bytesUsed += len;
+}
+
+uint32_t scrollbackFirstLine() {
+#if SCROLLBACK_SPILL
+  return spillFirstLine < firstLine ? spillFirstLine : firstLine;
+#else
+  return firstLine;
+#endif
+}
+
+uint32_t scrollbackEndLine() {
+  return endLine;
+}
+
+bool scrollbackHasLine(uint32_t line) {
+  return line >= scrollbackFirstLine() && line < endLine;
+}
+
+#if SCROLLBACK_SPILL
+
+// Record of a line in a page whose first line is pageFirst, nullptr if
+// the records run past the end of the page
+static const uint8_t* pageRecord(const uint8_t* page, uint32_t pageFirst, uint32_t line) {
+  uint32_t offset = 0;
+  for (uint32_t l = pageFirst;; l++) {
+    if (offset + RECORD_HEADER > SCROLLBACK_PAGE_SIZE) return nullptr;
+    uint32_t size = recordSize(page + offset);
+    if (offset + size > SCROLLBACK_PAGE_SIZE) return nullptr;
+    if (l == line) return page + offset;
+    offset += size;
+  }
+}
+
+// Spilled page holding a line (binary search over the page index)
+static uint32_t pageForLine(uint32_t line) {
+  uint32_t lo = spillFirstPage;
+  uint32_t hi = spillEndPage - 1;
+  while (lo < hi) {
+    uint32_t mid = lo + (hi - lo + 1) / 2;
+    if (pageFirstLine[mid % SCROLLBACK_SPILL_PAGES] <= line) {
+      lo = mid;
+    } else {
+      hi = mid - 1;
+    }
+  }
+  return lo;
+}
+
+// Cache slot holding or loading a page, -1 if none
+static int cacheFind(uint32_t page) {
+  for (int i = 0; i < SCROLLBACK_CACHE_PAGES; i++) {
+    if (cacheState[i].load(std::memory_order_acquire) != PAGE_FREE && cachePage[i] == page) return i;
+  }
+  return -1;
+}
+
+// Start reading a spilled page into the least recently used cache slot
+static void cacheLoad(uint32_t page, int keepSlot) {
+  if (page < spillFirstPage || page >= spillEndPage) return;
+  if (cacheFind(page) >= 0) return;
+  
+  // The last written pages are still in the fill buffers
+  for (int i = 0; i < 2; i++) {
+    if (i != fillIndex && fillPage[i] == page) return;
+  }
+  
+  int victim = -1;
+  for (int i = 0; i < SCROLLBACK_CACHE_PAGES; i++) {
+    uint8_t state = cacheState[i].load(std::memory_order_acquire);
+    if (state == PAGE_FREE) {
+      victim = i;
+      break;
+    }
+    if ((state == PAGE_READY || state == PAGE_FAILED) && i != keepSlot &&
+        (victim < 0 || cacheUsed[i] < cacheUsed[victim])) {
+      victim = i;
+    }
+  }
+  if (victim < 0) return;
+  
+  cachePage[victim] = page;
+  cacheUsed[victim] = ++cacheClock;
+  spillRequest(cacheBuffers[victim], &cacheState[victim], page, false);
+}
+
+// Spilled page contents if they are in RAM, nullptr if not (yet)
+static const uint8_t* spilledPage(uint32_t page) {
+  for (int i = 0; i < 2; i++) {
+    if (i != fillIndex && fillPage[i] == page) return fillBuffers[i];
+  }
+  int slot = cacheFind(page);
+  if (slot < 0 || cacheState[slot].load(std::memory_order_acquire) != PAGE_READY) return nullptr;
+  cacheUsed[slot] = ++cacheClock;
+  return cacheBuffers[slot];
+}
+
+#endif
+
+// Decode one record into count cells (padded with blanks)
+static void decodeRecord(const uint8_t* record, TermCell* cells, int count) {
+  const uint8_t* text = record + RECORD_HEADER + bloomSize(record[0]);
+  const uint8_t* textEnd = text + record[0];
+  const uint8_t* run = textEnd;
+  const uint8_t* runEnd = run + (record[1] & RECORD_RUNS_MASK) * RUN_SIZE;
+  
+  // Colors of the current run, default when the line has none
+  int runLeft = runEnd > run ? 0 : count;
+  uint8_t colors = CELL_DEFAULT_COLORS;
+  uint16_t attr = 0;
+  
+  UTF8Decoder decoder;
+  utf8Init(&decoder);
+  int x = 0;
+  while (x < count && text < textEnd) {
+    if (!utf8Decode(&decoder, *text++)) continue;
+    
+    if (runLeft == 0 && run < runEnd) {
+      runLeft = run[0];
+      colors = run[1];
+      attr = run[2] << 12;
+      run += RUN_SIZE;
+    }
+    runLeft--;
+    
+    cells[x].glyph = unicodeToFontIndex(utf8GetCodepoint(&decoder)) | attr;
+    cells[x].colors = colors;
+    utf8Init(&decoder);
+    x++;
+  }
+  
+  // Trimmed blanks
+  for (; x < count; x++) {
+    cells[x].glyph = ' ';
+    cells[x].colors = CELL_DEFAULT_COLORS;
+  }
+}
+
+// Record of a held line, nullptr if it is not held or its page is still
+// being read from SD
+static const uint8_t* findRecord(uint32_t line) {
+  if (!scrollbackHasLine(line)) return nullptr;
+  
+  const uint8_t* record = nullptr;
+  if (line >= firstLine) {
+    record = &arena[lineOffset[line % SCROLLBACK_MAX_LINES]];
+  }
+#if SCROLLBACK_SPILL
+  else if (fillUsed > 0 && line >= fillFirstLine) {
+    record = pageRecord(fillBuffers[fillIndex], fillFirstLine, line);
+  } else {
+    uint32_t page = pageForLine(line);
+    const uint8_t* buffer = spilledPage(page);
+    if (buffer == nullptr) cacheLoad(page, -1);
+    
+    // Read ahead both ways so dragging through history finds pages cached
+    int slot = cacheFind(page);
+    cacheLoad(page - 1, slot);
+    cacheLoad(page + 1, slot);
+    
+    if (buffer == nullptr) {
+      cacheMisses++;
+      return nullptr;
+    }
+    cacheHits++;
+    record = pageRecord(buffer, pageFirstLine[page % SCROLLBACK_SPILL_PAGES], line);
+  }
+#endif
+  return record;
+}
+
+bool scrollbackGetLine(uint32_t line, TermCell* cells, int count) {
+  const uint8_t* record = findRecord(line);
+  if (record == nullptr) return false;
+  
+  decodeRecord(record, cells, count);
+  return true;
+}
+
+bool scrollbackGetLineBloom(uint32_t line, uint64_t* bloom) {
+  const uint8_t* record = findRecord(line);
+  if (record == nullptr) return false;
+  
+  *bloom = 0;
+  if (bloomSize(record[0]) > 0) memcpy(bloom, record + RECORD_HEADER, BLOOM_SIZE);
+  return true;
+}
+
+bool scrollbackGetLineInfo(uint32_t line, int* length, bool* wrapped) {
+  const uint8_t* record = findRecord(line);
+  if (record == nullptr) return false;
+  
+  // One cell per character: count the bytes that start one
+  const uint8_t* text = record + RECORD_HEADER + bloomSize(record[0]);
+  int cells = 0;
+  for (int i = 0; i < record[0]; i++) {
+    if ((text[i] & 0xC0) != 0x80) cells++;
+  }
+  *length = cells;
+  *wrapped = record[1] & RECORD_WRAPPED;
+  return true;
+}
+
+uint32_t scrollbackFirstRamLine() {
+  return firstLine;
+}
+
+bool scrollbackPopLine() {
+  if (firstLine == endLine) return false;
+  
+  endLine--;
+  const uint8_t* record = &arena[lineOffset[endLine % SCROLLBACK_MAX_LINES]];
+  bytesUsed -= recordSize(record);
+  
+  // Records are appended in line order, the next one goes where the
+  // previous line's record ends
+  if (firstLine == endLine) {
+    arenaHead = 0;
+  } else {
+    const uint8_t* previous = &arena[lineOffset[(endLine - 1) % SCROLLBACK_MAX_LINES]];
+    arenaHead = previous - arena + recordSize(previous);
+  }
+  return true;
+}
+
+uint32_t scrollbackPageLoads() {
+#if SCROLLBACK_SPILL
+  return pageLoads.load(std::memory_order_acquire);
+#else
+  return 0;
+#endif
+}
+
+void scrollbackGetStats(ScrollbackStats* stats) {
+  stats->lines = endLine - scrollbackFirstLine();
+  stats->bytes = bytesUsed;
+  stats->evictedLines = evictedLines;
+#if SCROLLBACK_SPILL
+  stats->spilledPages = spillEndPage - spillFirstPage;
+  stats->cacheHits = cacheHits;
+  stats->cacheMisses = cacheMisses;
+  stats->spillFailed = spillFailed;
+#else
+  stats->spilledPages = 0;
+  stats->cacheHits = 0;
+  stats->cacheMisses = 0;
+  stats->spillFailed = false;
+#endif
+}
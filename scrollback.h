@@ -0,0 +1,84 @@
+/*
+ * scrollback.h - Compressed scrollback store
+ *
+ * Lines that scroll off the live screen are stored variable-length in a
+ * byte arena: trimmed UTF-8 text plus attribute runs. A ring of line
+ * offsets finds any held line in O(1). When the arena or the offset ring
+ * is full the oldest lines are evicted, so the number of lines held
+ * depends on how long they are, not on a fixed row count.
+ *
+ * With an SD card, evicted lines are not lost: they are written in pages
+ * to a spill file and paged back in asynchronously when scrolled to.
+ */
+
+#ifndef SCROLLBACK_H
+#define SCROLLBACK_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "termcell.h"
+
+// Scrollback statistics
+struct ScrollbackStats {
+  uint32_t lines;         // Lines held (RAM and SD)
+  uint32_t bytes;         // Arena bytes used by held lines
+  uint32_t evictedLines;  // Lines evicted from the arena (spilled or dropped)
+  uint32_t spilledPages;  // Pages held in the SD spill file
+  uint32_t cacheHits;     // Spilled line reads served from RAM
+  uint32_t cacheMisses;   // Spilled line reads that had to wait for the card
+  bool spillFailed;       // Spill file could not be opened, evicted lines are dropped
+};
+
+// Start the SD spill task if a card is mounted (call after sdInit())
+void scrollbackInit();
+
+// Drop all lines, the next pushed line gets number 0
+void scrollbackClear();
+
+// Store a finished line. Lines are numbered in push order. A wrapped line
+// was soft-wrapped into the next one at the right margin: it is stored
+// with its trailing blanks, so the two can be joined again.
+void scrollbackPushLine(const TermCell* cells, int count, bool wrapped);
+
+// Drop the newest line, e.g. when it moves back to the live screen.
+// Returns false if no line is held in RAM.
+bool scrollbackPopLine();
+
+// Lines [scrollbackFirstRamLine(), scrollbackEndLine()) are in RAM and can
+// be popped
+uint32_t scrollbackFirstRamLine();
+
+// Held lines are [scrollbackFirstLine(), scrollbackEndLine())
+uint32_t scrollbackFirstLine();
+uint32_t scrollbackEndLine();
+
+// True if the line is held
+bool scrollbackHasLine(uint32_t line);
+
+// Decode a held line into count cells (padded with blanks). Returns false
+// if the line is not held, or if it is spilled and its page is still being
+// read from the card - try again when scrollbackPageLoads() changes. Lines
+// of a page that could not be written or read back in full stay unreadable
+// until the page drops out of the cache.
+bool scrollbackGetLine(uint32_t line, TermCell* cells, int count);
+
+// Stored length in cells and wrap flag of a held line without decoding
+// it. Returns false like scrollbackGetLine if the line can't be read yet.
+bool scrollbackGetLineInfo(uint32_t line, int* length, bool* wrapped);
+
+// Bloom filter of a held line's trigrams without decoding it. Returns false
+// like scrollbackGetLine if the line can't be read yet.
+bool scrollbackGetLineBloom(uint32_t line, uint64_t* bloom);
+
+// Bloom filter of the trigrams of count case-folded font indices (see
+// fontIndexFoldCase). A line can only contain the text if its bloom has
+// all of the text's bits set.
+uint64_t scrollbackTrigramBloom(const uint16_t* glyphs, int count);
+
+// Number of pages read back from the card so far
+uint32_t scrollbackPageLoads();
+
+// Statistics
+void scrollbackGetStats(ScrollbackStats* stats);
+
+#endif
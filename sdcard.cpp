@@ -2,6 +2,7 @@
 #include "config.h"
 #include <SD.h>
 #include <SPI.h>
+#include "freertos/semphr.h"
 
 // SD card pins (ESP32 CYD)
 #define SD_CS   5
@@ -22,6 +23,7 @@ static File sessionFile;
 static char writeBuffer[BUFFER_SIZE];
 static int bufferPos = 0;
 static unsigned long lastFlushTime = 0;
+static SemaphoreHandle_t sdMutex = nullptr;
 
 // Line buffers for accumulating text until newline
 static char rxLineBuffer[LINE_BUFFER_SIZE];
@@ -35,11 +37,18 @@ static void flushBuffer();
 static void writeToBuffer(const char* data, size_t len);
 
 bool sdInit() {
+  // Created before any task can use the card
+  if (sdMutex == nullptr) {
+    sdMutex = xSemaphoreCreateRecursiveMutex();
+  }
+  
   // Initialize SPI for SD card
   SPI.begin(SD_SCK, SD_MISO, SD_MOSI, SD_CS);
   
   // Try to mount SD card
+  sdLock();
   if (!SD.begin(SD_CS)) {
+    sdUnlock();
     currentStatus = SD_NOT_PRESENT;
     return false;
   }
@@ -47,6 +56,7 @@ bool sdInit() {
   // Check card type
   uint8_t cardType = SD.cardType();
   if (cardType == CARD_NONE) {
+    sdUnlock();
     currentStatus = SD_NOT_PRESENT;
     return false;
   }
@@ -55,6 +65,7 @@ bool sdInit() {
   if (!SD.exists("/LOGS")) {
     SD.mkdir("/LOGS");
   }
+  sdUnlock();
   
   currentStatus = SD_READY;
   return true;
@@ -73,6 +84,8 @@ bool sdStartRecording() {
     return true;  // Already recording
   }
   
+  sdLock();
+  
   // Find next session number
   sessionNumber = findNextSessionNumber();
   
@@ -86,6 +99,7 @@ bool sdStartRecording() {
   // Open file for writing
   sessionFile = SD.open(filename, FILE_WRITE);
   if (!sessionFile) {
+    sdUnlock();
     currentStatus = SD_ERROR;
     return false;
   }
@@ -95,6 +109,7 @@ bool sdStartRecording() {
   sessionFile.print(sessionNumber);
   sessionFile.println(" Start ===");
   sessionFile.flush();
+  sdUnlock();
   
   isRecording = true;
   currentStatus = SD_RECORDING;
@@ -127,6 +142,7 @@ void sdStopRecording() {
   }
   
   // Flush remaining data
+  sdLock();
   flushBuffer();
   
   // Write session footer
@@ -136,6 +152,7 @@ void sdStopRecording() {
     sessionFile.println(" End ===");
     sessionFile.close();
   }
+  sdUnlock();
   
   isRecording = false;
   currentStatus = SD_READY;
@@ -241,6 +258,16 @@ void sdLogRXCodepoint(uint32_t codepoint) {
   }
 }
 
+void sdLogRXText(const char* text, size_t len) {
+  if (!isRecording) return;
+  
+  // Append whole run to line buffer (caller guarantees no line breaks)
+  size_t space = LINE_BUFFER_SIZE - 1 - rxLinePos;
+  if (len > space) len = space;
+  memcpy(&rxLineBuffer[rxLinePos], text, len);
+  rxLinePos += len;
+}
+
 void sdLogTXCodepoint(uint32_t codepoint) {
   if (!isRecording) return;
   
@@ -301,8 +328,12 @@ void sdCleanOldSessions() {
   const int MAX_SESSIONS = 50;
   
   // Count session files
+  sdLock();
   File root = SD.open("/LOGS");
-  if (!root) return;
+  if (!root) {
+    sdUnlock();
+    return;
+  }
   
   int fileCount = 0;
   File entry = root.openNextFile();
@@ -333,6 +364,19 @@ void sdCleanOldSessions() {
       }
     }
   }
+  sdUnlock();
+}
+
+void sdReportError() {
+  if (!isRecording) currentStatus = SD_ERROR;
+}
+
+void sdLock() {
+  if (sdMutex != nullptr) xSemaphoreTakeRecursive(sdMutex, portMAX_DELAY);
+}
+
+void sdUnlock() {
+  if (sdMutex != nullptr) xSemaphoreGiveRecursive(sdMutex);
 }
 
 // Private functions
@@ -369,8 +413,10 @@ static int findNextSessionNumber() {
 static void flushBuffer() {
   if (bufferPos == 0 || !isRecording || !sessionFile) return;
   
+  sdLock();
   sessionFile.write((uint8_t*)writeBuffer, bufferPos);
   sessionFile.flush();
+  sdUnlock();
   bufferPos = 0;
 }
 
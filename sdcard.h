@@ -38,6 +38,9 @@ void sdLogRXChar(char c);
 // Log a single character (TX)
 void sdLogTXChar(char c);
 
+// Log a run of text without line breaks (RX)
+void sdLogRXText(const char* text, size_t len);
+
 // Log a codepoint (converts to UTF-8)
 void sdLogRXCodepoint(uint32_t codepoint);
 void sdLogTXCodepoint(uint32_t codepoint);
@@ -51,4 +54,14 @@ int sdGetSessionNumber();
 // Clean old sessions (keep last 50)
 void sdCleanOldSessions();
 
+// Report a failed file operation from outside this module: the status
+// becomes SD_ERROR (dark REC icon) unless a recording is running
+void sdReportError();
+
+// Lock around every use of the SD/FS instance. Session logging runs in
+// loop(), the scrollback spill task on the other core. Recursive, the
+// functions above take it themselves.
+void sdLock();
+void sdUnlock();
+
 #endif
@@ -0,0 +1,45 @@
+/*
+ * termcell.h - Packed terminal screen cell
+ */
+
+#ifndef TERMCELL_H
+#define TERMCELL_H
+
+#include <Arduino.h>
+
+// Attribute bits, stored in the top 4 bits of the glyph field
+#define CELL_GLYPH_MASK 0x0FFF
+#define CELL_BOLD       0x1000
+#define CELL_UNDERLINE  0x2000
+#define CELL_INVERSE    0x4000
+
+// Palette indices (ANSI colors 0-7, bright colors 8-15)
+#define CELL_DEFAULT_FG 2   // Green
+#define CELL_DEFAULT_BG 0   // Black
+#define CELL_DEFAULT_COLORS ((CELL_DEFAULT_FG << 4) | CELL_DEFAULT_BG)
+
+// One character cell - 3 bytes
+struct __attribute__((packed)) TermCell {
+  uint16_t glyph;   // Font index (see unicodeToFontIndex) | CELL_* attributes
+  uint8_t colors;   // Foreground palette index << 4 | background palette index
+};
+
+static_assert(sizeof(TermCell) == 3, "TermCell must stay packed");
+
+// RGB565 values of the 16 palette entries (defined in renderer.cpp)
+extern const uint16_t terminalPalette[16];
+
+inline uint8_t cellFg(const TermCell& cell) {
+  return cell.colors >> 4;
+}
+
+inline uint8_t cellBg(const TermCell& cell) {
+  return cell.colors & 0x0F;
+}
+
+// Blank cell: space on the default background with nothing drawn over it
+inline bool cellIsBlank(const TermCell& cell) {
+  return (cell.glyph & ~CELL_BOLD) == ' ' && cellBg(cell) == CELL_DEFAULT_BG;
+}
+
+#endif
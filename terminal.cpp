@@ -6,235 +6,794 @@
 #include "display.h"
 #include "utf8.h"
 #include "sdcard.h"
+#include "uartio.h"
+#include "vtparser.h"
+#include "renderer.h"
+#include "termcell.h"
+#include "scrollback.h"
+#include "reflow.h"
 
 // Forward declarations
 void terminalRedraw();
-void drawCursor(bool visible);
 void scrollUp();
 void putChar(uint32_t codepoint);
-void processEscSequence();
+static void markDirty(int row, int from, int to);
+static void markAllDirty();
 void drawScrollbar(int maxY);
+static void searchStep();
+static void stopPixelScroll();
 
 // Terminal state
 static int currentBaudRate = 115200;
 static int currentMode = 0; // 0 = USB, 1 = External
-static HardwareSerial* terminalSerial = nullptr;
 
-// Screen buffer - now stores Unicode codepoints with scrollback
-static uint32_t screenBuffer[TERMINAL_BUFFER_ROWS][TERMINAL_COLS];
+// Grid of the current cell font: terminalCols x terminalRows cells of
+// cellWidth x cellHeight pixels
+static int currentFont = CELL_FONT_6X8;
+static int terminalCols = 53;
+static int terminalRows = 27;
+static int cellWidth = 6;
+static int cellHeight = 8;
+
+// Live screen - packed cells (font index, colors, attributes) of the newest
+// terminalRows lines. Older lines move to the compressed scrollback store.
+// Rows that ran into the right margin and continued on the next row are
+// marked wrapped, so lines can be rewrapped when the grid width changes.
+static TermCell screenBuffer[TERMINAL_MAX_ROWS][TERMINAL_MAX_COLS];
+static bool rowWrapped[TERMINAL_MAX_ROWS];
 static int cursorX = 0;
 static int cursorY = 0;
 static int scrollOffset = 0;  // Current scroll position (0 = bottom)
+static int scrollPixel = 0;   // Pixels scrolled back past scrollOffset (below cellHeight), keyboard hidden only
 static int totalLines = 0;    // Total lines written
 
-// Colors
-static uint16_t fgColor = TFT_GREEN;
-static uint16_t bgColor = TFT_BLACK;
+// Current colors (palette indices, fg << 4 | bg) and CELL_* attributes (SGR)
+static uint8_t currentColors = CELL_DEFAULT_COLORS;
+static uint16_t currentAttr = 0;
+
+// ESC sequence parser
+static VTParser vtParser;
+static void vtPrint(uint8_t byte);
+static void vtExecute(uint8_t byte);
+static void vtEscDispatch(const VTParser* parser, uint8_t finalByte);
+static void vtCsiDispatch(const VTParser* parser, uint8_t finalByte);
 
-// ESC sequence parser state
-static char escBuffer[32];
-static int escIndex = 0;
-static bool inEscSequence = false;
+static const VTParserHandlers vtHandlers = {
+  vtPrint,
+  vtExecute,
+  vtEscDispatch,
+  vtCsiDispatch,
+  nullptr,  // DCS hook - DCS strings are swallowed
+  nullptr,  // DCS put
+  nullptr,  // DCS unhook
+  nullptr,  // OSC start - OSC strings (window title etc.) are swallowed
+  nullptr,  // OSC put
+  nullptr   // OSC end
+};
+
+// Character set and cursor state controlled by ESC sequences
+static bool g0LineDrawing = false;   // ESC ( 0 selects DEC Special Graphics
+static bool singleShiftPending = false; // SS2/SS3: next character comes from G2/G3
+static bool cursorVisible = true;    // DECTCEM (ESC[?25h / ESC[?25l)
+static int cursorShape = CURSOR_SHAPE; // DECSCUSR (ESC[n q): 1/2 block, 3/4 underline, 5/6 bar, odd blinks
+static int savedCursorX = 0;
+static int savedCursorY = 0;
 
 // UTF-8 decoder
 static UTF8Decoder utf8Decoder;
 
+// Painted extent of each scanline (cells from the left that may hold
+// non-background pixels), so repaints only touch what is on the glass.
+// Kept per scanline because pixel scrolling moves rows off the cell grid.
+static uint8_t glassLength[SCREEN_HEIGHT];
+
+// Rows are clipped to the text area above this scanline in the current frame
+static int clipBottom = SCREEN_HEIGHT;
+
+// Damage: the parser only marks the changed cell span [dirtyFrom, dirtyTo)
+// of each buffer row, the renderer flushes it at most RENDER_FPS_MAX times
+// a second (or right away when RX is idle)
+static uint8_t dirtyFrom[TERMINAL_MAX_ROWS];
+static uint8_t dirtyTo[TERMINAL_MAX_ROWS];
+static bool fullDamage = true;
+static unsigned long lastFrameTime = 0;
+
+// Line numbers: lines count from 0 in the order they were written, but
+// history rows (reflowed to the current width) are numbered down from the
+// first live line, so they may go negative
+#define NO_LINE INT32_MIN
+
+// What the last frame put on screen
+static int32_t shownLine[TERMINAL_MAX_ROWS + 1]; // Line number shown at each screen row, NO_LINE = empty
+static int shownRows = -1;
+static int shownMaxY = -1;
+static int shownCursorRow = -1;
+static int shownCursorX = -1;
+static int shownCursorShape = 0;
+static bool shownCursorDrawn = false;  // Cursor is on the glass (blink phase on)
+static int shownTotalLines = -1;
+static int shownOldestLine = 0;
+static int shownScrollOffset = -1;
+static int shownRowShift = 0;
+static int shownScrollPixel = 0;
+static bool shownPending[TERMINAL_MAX_ROWS + 1];  // Row waits for its scrollback page from SD
+static uint32_t shownPageLoads = 0;
+
+// Shadow screen: the cells each screen row shows on the glass, so a frame
+// only pushes the cells that differ. A row's shadow is invalid when nothing
+// is known about its pixels (not shown, or painted over).
+static TermCell shownCells[TERMINAL_MAX_ROWS + 1][TERMINAL_MAX_COLS];
+static bool shownValid[TERMINAL_MAX_ROWS + 1];
+
+// Cursor blink: the phase flips every CURSOR_BLINK_MS and starts over on
+// when the cursor moves
+static bool cursorBlinkOn = true;
+static unsigned long cursorBlinkTime = 0;
+
+// Repaint statistics
+static TerminalRenderStats renderStats;
+static uint32_t frameCells = 0;
+static uint32_t frameBytes = 0;
+
+// Kinetic scrolling - fling velocity in pixels per second (> 0 = back in
+// history), slowed down by SCROLL_FLING_DECEL as terminalUpdateFling() runs
+static float flingVelocity = 0;
+static float flingRemainder = 0;  // Distance below one pixel not scrolled yet
+static unsigned long flingLastUpdate = 0;
+
+// Scrollback search - the query as font indices and its trigram bloom.
+// A search walks SEARCH_LINES_PER_STEP lines per frame from searchNextLine
+// and pauses where a spilled page has to be read from SD first.
+static bool searchActive = false;
+static uint16_t searchText[SEARCH_MAX_QUERY];
+static int searchLength = 0;
+static uint64_t searchBloom = 0;
+static int searchMatchLine = -1;     // Line of the current match (scrollback line number), -1 = none
+static int searchMatchX = 0;
+static int searchMatchRow = 0;       // Where the match is shown (line number and column)
+static int searchMatchColumn = 0;
+static int searchNextLine = 0;       // Next line to check
+static int searchNextX = 0;          // Column the walk continues from in searchNextLine
+static int searchDirection = 0;      // -1 = towards older lines, 1 = newer, 0 = idle
+static bool searchFailed = false;    // Last search ran out of lines
+static bool searchWaiting = false;   // Waiting for a scrollback page
+static uint32_t searchWaitLoads = 0;
+static int searchTotalLines = 0;     // Line count when the view was moved to the match
+
+// Highlight colors (fg << 4 | bg): black on yellow for the current match,
+// white on blue for the others
+#define SEARCH_CURRENT_COLORS ((0 << 4) | 3)
+#define SEARCH_MATCH_COLORS ((15 << 4) | 4)
+#define SEARCH_PROMPT_COLORS ((0 << 4) | 6)
+
+// Erase cells to blanks with the current background (like xterm)
+static void eraseCells(TermCell* cells, int count) {
+  uint8_t colors = (CELL_DEFAULT_FG << 4) | (currentColors & 0x0F);
+  for (int x = 0; x < count; x++) {
+    cells[x].glyph = ' ';
+    cells[x].colors = colors;
+  }
+}
+
 // Baud rates array
 const int baudRates[] = {9600, 19200, 38400, 57600, 115200, 230400};
 
-void terminalInit(int baudRateIndex, int mode) {
+// Grid size and cell size of a cell font
+static void setGeometry(int font) {
+  currentFont = font;
+  cellWidth = cellFontWidth(font);
+  cellHeight = cellFontHeight(font);
+  terminalCols = SCREEN_WIDTH / cellWidth;
+  terminalRows = (SCREEN_HEIGHT - TERMINAL_START_Y) / cellHeight;
+  rendererSetFont(font);
+  reflowSetFont(font);
+}
+
+void terminalInit(int baudRateIndex, int mode, int font) {
   currentMode = mode;
   currentBaudRate = baudRates[baudRateIndex];
+  if (font < 0 || font >= CELL_FONT_COUNT) font = TERMINAL_FONT;
+  setGeometry(font);
   
-  // Initialize UTF-8 decoder
+  // Initialize UTF-8 decoder and ESC parser
   utf8Init(&utf8Decoder);
+  vtParserInit(&vtParser, &vtHandlers);
   
   // Clear screen buffer
-  for (int y = 0; y < TERMINAL_BUFFER_ROWS; y++) {
-    for (int x = 0; x < TERMINAL_COLS; x++) {
-      screenBuffer[y][x] = ' ';
-    }
+  currentColors = CELL_DEFAULT_COLORS;
+  currentAttr = 0;
+  for (int y = 0; y < terminalRows; y++) {
+    eraseCells(screenBuffer[y], terminalCols);
   }
+  memset(rowWrapped, 0, sizeof(rowWrapped));
+  scrollbackInit();
+  scrollbackClear();
+  reflowClear();
   
   cursorX = 0;
   cursorY = 0;
   scrollOffset = 0;
   totalLines = 0;
+  stopPixelScroll();
   
-  // Initialize UART
-  if (currentMode == 0) {
-    // USB UART (Serial)
-    Serial.begin(currentBaudRate);
-    terminalSerial = &Serial;
-  } else {
-    // External UART on GPIO3/1
-    Serial2.begin(currentBaudRate, SERIAL_8N1, UART_RX, UART_TX);
-    terminalSerial = &Serial2;
-  }
+  // Row rasterizer (enables DMA)
+  rendererInit();
   
-  // Draw initial terminal screen
-  terminalRedraw();
+  // Initialize UART and start the RX task
+  uartIoBegin(currentBaudRate, currentMode);
+  
+  // Initial terminal screen is painted by the first terminalRender()
+  markAllDirty();
 }
 
-void terminalRedraw() {
-  // Redraw visible portion of buffer with scroll offset
-  tft.setTextColor(fgColor, bgColor);
-  tft.setTextFont(1);
-  tft.setTextSize(1);
-  
-  // Check if keyboard is visible (external variable from main)
+// Absolute line number of the cursor line
+static int cursorLineNumber() {
+  if (totalLines <= terminalRows) {
+    return cursorY;
+  }
+  // In circular buffer, find absolute line number of cursor
+  int newestLinePos = (totalLines - 1) % terminalRows;
+  int offset = (newestLinePos - cursorY + terminalRows) % terminalRows;
+  return totalLines - 1 - offset;
+}
+
+// Buffer row holding an absolute line number, or -1 if the line
+// doesn't exist yet or was already overwritten
+static int bufferRowForLine(int lineNumber) {
+  if (lineNumber < 0 || lineNumber >= totalLines) return -1;
+  if (totalLines <= terminalRows) return lineNumber;
+  if (lineNumber < totalLines - terminalRows) return -1;
+  return lineNumber % terminalRows;
+}
+
+// First live line, scrollback holds the lines before it
+static int liveFirstLine() {
+  return totalLines > terminalRows ? totalLines - terminalRows : 0;
+}
+
+// Oldest line that can still be shown (live screen or history row)
+static int oldestLine() {
+  if (totalLines <= terminalRows) return 0;
+  return liveFirstLine() - reflowRowCount();
+}
+
+// Oldest line still held as written (live screen or scrollback)
+static int oldestStoredLine() {
+  if (totalLines <= terminalRows) return 0;
+  return scrollbackFirstLine();
+}
+
+// Number of lines that can be scrolled through
+static int historyLines() {
+  return totalLines - oldestLine();
+}
+
+// Buffer row of a live screen row (0 = top of the screen)
+static int liveRow(int screenRow) {
+  if (totalLines <= terminalRows) return screenRow;
+  return (totalLines + screenRow) % terminalRows;
+}
+
+// Live screen row of the cursor
+static int cursorScreenRow() {
+  if (totalLines <= terminalRows) return cursorY;
+  return cursorLineNumber() - (totalLines - terminalRows);
+}
+
+// Text rows shown above the keyboard or on the whole screen
+static int visibleRowCount() {
   extern bool keyboardVisible;
   int maxY = keyboardVisible ? KEYBOARD_Y_POS : (SCREEN_HEIGHT);
-  int visibleRows = (maxY - TERMINAL_START_Y) / 8;
-  if (visibleRows > TERMINAL_ROWS) visibleRows = TERMINAL_ROWS;
+  int visibleRows = (maxY - TERMINAL_START_Y) / cellHeight;
+  if (visibleRows > terminalRows) visibleRows = terminalRows;
   
   // When keyboard is visible, show only 5 rows to ensure cursor line (6th) is fully visible and higher up
   if (keyboardVisible && visibleRows > 5) {
     visibleRows = 5;
   }
+  return visibleRows;
+}
+
+// Mark cells [from, to) of a buffer row as changed
+static void markDirty(int row, int from, int to) {
+  if (dirtyFrom[row] >= dirtyTo[row]) {
+    dirtyFrom[row] = from;
+    dirtyTo[row] = to;
+  } else {
+    if (from < dirtyFrom[row]) dirtyFrom[row] = from;
+    if (to > dirtyTo[row]) dirtyTo[row] = to;
+  }
+}
+
+// Repaint the whole terminal area on the next frame
+static void markAllDirty() {
+  fullDamage = true;
+}
+
+// fillRect that is counted in the frame stats
+static void renderFill(int x, int y, int w, int h, uint16_t color) {
+  rendererFillRect(x, y, w, h, color);
+  frameBytes += w * h * 2;
+}
+
+// Note that cells [0, length) of scanline y hold painted pixels
+static void markPainted(int y, int length) {
+  if (y >= 0 && y < SCREEN_HEIGHT && glassLength[y] < length) {
+    glassLength[y] = length;
+  }
+}
+
+// Widest painted extent of scanlines [top, bottom)
+static int glassExtent(int top, int bottom) {
+  int extent = 0;
+  for (int y = top; y < bottom; y++) {
+    if (glassLength[y] > extent) extent = glassLength[y];
+  }
+  return extent;
+}
+
+// Paint cells [from, to) of a line as one pushed window, the row's top at
+// screenY. Rows moved off the grid by a pixel scroll are clipped to the
+// text area. Blank cells past the last non-blank one are only pushed where
+// something was painted before, so repaints cost what is actually on screen.
+static void paintRow(const TermCell* cells, int screenY, int from, int to) {
+  int top = screenY > TERMINAL_START_Y ? screenY : TERMINAL_START_Y;
+  int bottom = screenY + cellHeight < clipBottom ? screenY + cellHeight : clipBottom;
+  if (top >= bottom) return;
+  
+  int length = terminalCols;
+  while (length > 0 && cellIsBlank(cells[length - 1])) length--;
+  
+  int painted = glassExtent(top, bottom);
+  int end = length > painted ? length : painted;
+  if (end > to) end = to;
+  if (end > from) {
+    rendererDrawCellRows(cells + from, end - from, from * cellWidth, top, top - screenY, bottom - top);
+    frameCells += end - from;
+    frameBytes += (end - from) * cellWidth * (bottom - top) * 2;
+  }
   
-  // Calculate which lines to show
-  int firstLineToShow = totalLines - visibleRows - scrollOffset;
-  if (firstLineToShow < 0) firstLineToShow = 0;
-  
-  // Draw visible lines
-  for (int y = 0; y < visibleRows; y++) {
-    int lineNumber = firstLineToShow + y;
-    if (lineNumber >= totalLines) break; // Don't show lines that don't exist yet
-    
-    // Map line number to buffer position (handle circular buffer)
-    int bufferLine;
-    if (totalLines <= TERMINAL_BUFFER_ROWS) {
-      // Buffer not full yet, direct mapping
-      bufferLine = lineNumber;
-    } else {
-      // Buffer is circular
-      // Oldest line in buffer is at position: totalLines % TERMINAL_BUFFER_ROWS
-      int oldestLineNumber = totalLines - TERMINAL_BUFFER_ROWS;
-      if (lineNumber < oldestLineNumber) {
-        // Line is too old, was overwritten
-        continue;
-      }
-      bufferLine = lineNumber % TERMINAL_BUFFER_ROWS;
+  // Cells outside the span keep what they had
+  int drawTo = to < length ? to : length;
+  for (int y = top; y < bottom; y++) {
+    if (to < glassLength[y]) continue;
+    int kept = from < glassLength[y] ? from : glassLength[y];
+    glassLength[y] = drawTo > kept ? drawTo : kept;
+  }
+}
+
+// Clear a row that has no line to show
+static void clearRow(int screenY) {
+  int top = screenY > TERMINAL_START_Y ? screenY : TERMINAL_START_Y;
+  int bottom = screenY + cellHeight < clipBottom ? screenY + cellHeight : clipBottom;
+  if (top >= bottom) return;
+  
+  int painted = glassExtent(top, bottom);
+  if (painted > 0) {
+    renderFill(0, top, painted * cellWidth, bottom - top, terminalPalette[CELL_DEFAULT_BG]);
+    memset(&glassLength[top], 0, bottom - top);
+  }
+}
+
+// Draw the cursor over the cell at screen row and column x, the rows
+// shifted by rowShift. Only covers pixels of that cell.
+static void drawCursor(int row, int x, int rowShift) {
+  int screenY = TERMINAL_START_Y + row * cellHeight + rowShift;
+  int top = screenY > TERMINAL_START_Y ? screenY : TERMINAL_START_Y;
+  int bottom = screenY + cellHeight < clipBottom ? screenY + cellHeight : clipBottom;
+  if (top >= bottom) return;
+  
+  uint16_t color = terminalPalette[CELL_DEFAULT_FG];
+  switch ((cursorShape + 1) / 2) {
+    case 1: { // Block: the cell inverted
+      TermCell cell = shownCells[row][x];
+      cell.glyph ^= CELL_INVERSE;
+      rendererDrawCellRows(&cell, 1, x * cellWidth, top, top - screenY, bottom - top);
+      frameCells++;
+      frameBytes += cellWidth * (bottom - top) * 2;
+      break;
+    }
+    case 2: // Underline: the bottom scanline
+      top = screenY + cellHeight - 1;
+      if (top < TERMINAL_START_Y || top >= bottom) return;
+      renderFill(x * cellWidth, top, cellWidth, 1, color);
+      break;
+    default: // Bar: the left pixel column
+      renderFill(x * cellWidth, top, 1, bottom - top, color);
+      break;
+  }
+  for (int y = top; y < bottom; y++) {
+    markPainted(y, x + 1);
+  }
+}
+
+// True if the query matches the cells starting at column x of count
+static bool searchMatchesAt(const TermCell* cells, int count, int x) {
+  if (x + searchLength > count) return false;
+  for (int i = 0; i < searchLength; i++) {
+    if (fontIndexFoldCase(cells[x + i].glyph & CELL_GLYPH_MASK) != fontIndexFoldCase(searchText[i])) {
+      return false;
     }
+  }
+  return true;
+}
+
+// Recolor the search matches in a copy of a line's cells
+static void highlightMatches(TermCell* cells, int line) {
+  for (int x = 0; x + searchLength <= terminalCols; x++) {
+    if (!searchMatchesAt(cells, terminalCols, x)) continue;
     
-    // Draw this line
-    for (int x = 0; x < TERMINAL_COLS; x++) {
-      drawUnicodeChar(screenBuffer[bufferLine][x], x * 6, TERMINAL_START_Y + y * 8, fgColor, bgColor, 1);
+    uint8_t colors = (line == searchMatchRow && x == searchMatchColumn) ? SEARCH_CURRENT_COLORS : SEARCH_MATCH_COLORS;
+    for (int i = 0; i < searchLength; i++) {
+      cells[x + i].glyph &= ~CELL_INVERSE;
+      cells[x + i].colors = colors;
     }
+    x += searchLength - 1;
+  }
+}
+
+// Search prompt row: the query and how the search went
+static void buildSearchPrompt(TermCell* cells) {
+  const char* label = "Find: ";
+  const char* status = searchDirection != 0 ? " ..." : (searchFailed ? " - not found" : "");
+  
+  int x = 0;
+  for (const char* c = label; *c && x < terminalCols; c++) {
+    cells[x++].glyph = *c;
   }
+  for (int i = 0; i < searchLength && x < terminalCols; i++) {
+    cells[x++].glyph = searchText[i];
+  }
+  for (const char* c = status; *c && x < terminalCols; c++) {
+    cells[x++].glyph = *c;
+  }
+  for (; x < terminalCols; x++) {
+    cells[x].glyph = ' ';
+  }
+  for (x = 0; x < terminalCols; x++) {
+    cells[x].colors = SEARCH_PROMPT_COLORS;
+  }
+}
+
+// Flush the accumulated damage to the screen (checkAll: compare every row
+// with the shadow), returns false if there was nothing to paint
+static bool renderFrame(bool checkAll) {
+  unsigned long frameStart = micros();
+  frameCells = 0;
+  frameBytes = 0;
   
-  // When keyboard is visible, handle cursor line and clear artifacts
+  // Check if keyboard is visible (external variable from main)
   extern bool keyboardVisible;
-  if (keyboardVisible) {
-    // Calculate cursor's absolute line number
-    int cursorLineNumber;
-    if (totalLines <= TERMINAL_BUFFER_ROWS) {
-      cursorLineNumber = cursorY;
-    } else {
-      int newestLinePos = (totalLines - 1) % TERMINAL_BUFFER_ROWS;
-      int offset = (newestLinePos - cursorY + TERMINAL_BUFFER_ROWS) % TERMINAL_BUFFER_ROWS;
-      cursorLineNumber = totalLines - 1 - offset;
+  int maxY = keyboardVisible ? KEYBOARD_Y_POS : (SCREEN_HEIGHT);
+  int visibleRows = visibleRowCount();
+  
+  // The search prompt takes the row below the text while searching
+  bool prompt = searchActive && keyboardVisible;
+  
+  // Calculate which lines to show
+  int oldest = oldestLine();
+  int liveFirst = liveFirstLine();
+  int firstLineToShow = totalLines - visibleRows - scrollOffset;
+  if (firstLineToShow < oldest) firstLineToShow = oldest;
+  
+  // When keyboard is visible the cursor line may be shown one row below
+  // the visible rows (the 6th line when showing 5)
+  int cursorLine = cursorLineNumber();
+  int rows = visibleRows;
+  if (keyboardVisible && !prompt && cursorLine == firstLineToShow + visibleRows && cursorLine <= totalLines - 1 &&
+      TERMINAL_START_Y + (visibleRows + 1) * cellHeight <= maxY) {
+    rows++;
+  }
+  
+  // A pixel scroll moves all rows down by scrollPixel: the line above the
+  // view shows at the top, the bottom row is cut off at the text area end
+  int rowShift = 0;
+  clipBottom = maxY;
+  if (!keyboardVisible && scrollPixel > 0) {
+    rowShift = scrollPixel - cellHeight;
+    firstLineToShow--;
+    rows++;
+    clipBottom = TERMINAL_START_Y + visibleRows * cellHeight;
+  }
+  
+  // Cursor screen row, -1 if hidden or out of view
+  int cursorRow = -1;
+  if (cursorVisible && cursorLine >= firstLineToShow && cursorLine <= firstLineToShow + visibleRows &&
+      TERMINAL_START_Y + (cursorLine - firstLineToShow) * cellHeight + rowShift < maxY) {
+    cursorRow = cursorLine - firstLineToShow;
+  }
+  // Below the painted rows (the prompt, or scrolled back by a full screen)
+  // its cell is not on the shadow
+  if (cursorRow >= rows) cursorRow = -1;
+  
+  // Layout changes (keyboard shown or hidden, pixel scroll) check every row.
+  // Rows only move on the glass with the pixel scroll (or its clipping).
+  bool full = fullDamage || rows != shownRows || maxY != shownMaxY || rowShift != shownRowShift;
+  if (rowShift != shownRowShift || (rowShift != 0 && maxY != shownMaxY)) {
+    memset(shownValid, 0, sizeof(shownValid));
+  }
+  bool cursorMoved = cursorRow != shownCursorRow || cursorX != shownCursorX || cursorShape != shownCursorShape;
+  if (cursorMoved) {
+    // A cursor that moved shows at once
+    cursorBlinkOn = true;
+    cursorBlinkTime = millis();
+  }
+  
+  // Spilled scrollback pages that arrived from SD complete pending rows
+  uint32_t pageLoads = scrollbackPageLoads();
+  bool pagesArrived = pageLoads != shownPageLoads;
+  shownPageLoads = pageLoads;
+  
+  // Check rows that show another line than last frame, plus the damaged
+  // part of rows that still show the same line, and repaint the cells that
+  // differ from the shadow
+  rendererBeginFrame();
+  int rowsPainted = 0;
+  bool cursorRowPainted = false;
+  bool lastColumnPainted = false;
+  for (int y = 0; y < rows; y++) {
+    int line = firstLineToShow + y;
+    int bufferLine = bufferRowForLine(line);
+    if (bufferLine < 0 && (line < oldest || line >= liveFirst)) line = NO_LINE;
+    
+    // Live lines have per-row damage, history rows never change (a row
+    // that left the live screen with damage not yet drawn is invalidated
+    // in scrollUp())
+    int from = 0;
+    int to = 0;
+    if (full || checkAll || line != shownLine[y] || (pagesArrived && shownPending[y]) || !shownValid[y]) {
+      to = terminalCols;
+    } else if (bufferLine >= 0) {
+      from = dirtyFrom[bufferLine];
+      to = dirtyTo[bufferLine];
     }
+    bool eraseCursor = cursorMoved && shownCursorDrawn && y == shownCursorRow && shownCursorX < terminalCols;
+    if (from >= to && !eraseCursor) continue;
     
-    // Check if cursor line is beyond the visible rows (the 6th line when showing 5)
-    if (cursorLineNumber == firstLineToShow + visibleRows && cursorLineNumber <= totalLines - 1) {
-      int bufferLine;
-      if (totalLines <= TERMINAL_BUFFER_ROWS) {
-        bufferLine = cursorLineNumber;
+    shownPending[y] = false;
+    const TermCell* cells = nullptr;
+    TermCell lineCells[TERMINAL_MAX_COLS];
+    if (bufferLine >= 0) {
+      cells = screenBuffer[bufferLine];
+    } else if (line != NO_LINE) {
+      if (reflowGetRow(liveFirst - line, lineCells, terminalCols)) {
+        cells = lineCells;
       } else {
-        bufferLine = cursorLineNumber % TERMINAL_BUFFER_ROWS;
+        // Page is being read from SD - blank until it arrives
+        shownPending[y] = true;
       }
-      
-      // Draw cursor line at screen position visibleRows (6th line)
-      int screenY = TERMINAL_START_Y + visibleRows * 8;
-      if (screenY + 8 <= maxY) {
-        // First, clear the line area to remove old content
-        tft.fillRect(0, screenY, SCREEN_WIDTH - 4, 8, bgColor);
-        
-        // Then draw the content from buffer
-        for (int x = 0; x < TERMINAL_COLS; x++) {
-          drawUnicodeChar(screenBuffer[bufferLine][x], x * 6, screenY, fgColor, bgColor, 1);
-        }
-        
-        // Clear area below cursor line up to keyboard (remove artifacts)
-        int clearStartY = screenY + 8;  // Start below cursor line
-        int clearHeight = maxY - clearStartY;
-        if (clearHeight > 0) {
-          tft.fillRect(0, clearStartY, SCREEN_WIDTH, clearHeight, bgColor);
-        }
+    }
+    
+    // Search matches may start or end outside the damaged span
+    if (cells != nullptr && searchLength > 0) {
+      if (cells != lineCells) memcpy(lineCells, cells, terminalCols * sizeof(TermCell));
+      highlightMatches(lineCells, line);
+      cells = lineCells;
+      from = 0;
+      to = terminalCols;
+    }
+    shownLine[y] = line;
+    
+    // Rows without cells are cleared, the shadow holds blanks for them
+    if (cells == nullptr) {
+      for (int x = 0; x < terminalCols; x++) {
+        lineCells[x].glyph = ' ';
+        lineCells[x].colors = CELL_DEFAULT_COLORS;
       }
-    } else {
-      // Cursor line is within visibleRows, just clear area below last visible row
-      int lastRowY = TERMINAL_START_Y + visibleRows * 8;
-      int clearHeight = maxY - lastRowY;
-      if (clearHeight > 0) {
-        tft.fillRect(0, lastRowY, SCREEN_WIDTH, clearHeight, bgColor);
+      from = 0;
+      to = terminalCols;
+    }
+    
+    // Only cells that differ from the glass are pushed
+    TermCell* shadow = shownCells[y];
+    const TermCell* model = cells != nullptr ? cells : lineCells;
+    if (shownValid[y] && from < to) {
+      if (memcmp(model + from, shadow + from, (to - from) * sizeof(TermCell)) == 0) {
+        to = from;
+      } else {
+        while (memcmp(&model[from], &shadow[from], sizeof(TermCell)) == 0) from++;
+        while (memcmp(&model[to - 1], &shadow[to - 1], sizeof(TermCell)) == 0) to--;
       }
     }
+    
+    // Erase the cursor from its old cell
+    if (eraseCursor) {
+      if (from >= to) {
+        from = shownCursorX;
+        to = shownCursorX + 1;
+      } else {
+        if (shownCursorX < from) from = shownCursorX;
+        if (shownCursorX + 1 > to) to = shownCursorX + 1;
+      }
+    }
+    if (from >= to) continue;
+    
+    int screenY = TERMINAL_START_Y + y * cellHeight + rowShift;
+    if (cells != nullptr) {
+      paintRow(cells, screenY, from, to);
+    } else {
+      clearRow(screenY);
+    }
+    memcpy(shadow + from, model + from, (to - from) * sizeof(TermCell));
+    shownValid[y] = true;
+    rowsPainted++;
+    if (y == cursorRow) cursorRowPainted = true;
+    if (to * cellWidth > SCREEN_WIDTH - 4) lastColumnPainted = true;
   }
-
   
-  // Clear scrollbar area first (before deciding whether to draw it)
-  const int scrollbarX = SCREEN_WIDTH - 4;
-  const int scrollbarWidth = 3;
-  tft.fillRect(scrollbarX, TERMINAL_START_Y, scrollbarWidth, maxY - TERMINAL_START_Y, bgColor);
+  if (prompt && full) {
+    TermCell cells[TERMINAL_MAX_COLS];
+    buildSearchPrompt(cells);
+    paintRow(cells, TERMINAL_START_Y + rows * cellHeight, 0, terminalCols);
+    rowsPainted++;
+    lastColumnPainted = true;
+  }
   
-  // Draw scrollbar if there's content to scroll (AFTER clearing area)
-  if (totalLines > visibleRows) {
-    drawScrollbar(maxY);
+  // Scrollbar only changes with the scroll position or line count, but the
+  // last text column overlaps it. The history row count is checked after
+  // the rows, fetching them may have measured more reflowed lines.
+  bool scrollbarChanged = full || lastColumnPainted || oldestLine() != shownOldestLine ||
+                          totalLines != shownTotalLines || scrollOffset != shownScrollOffset ||
+                          rowShift != shownRowShift || scrollPixel != shownScrollPixel;
+  
+  if (rowsPainted == 0 && !cursorMoved && !scrollbarChanged) {
+    rendererEndFrame();
+    memset(dirtyFrom, 0, sizeof(dirtyFrom));
+    memset(dirtyTo, 0, sizeof(dirtyTo));
+    return false;
   }
   
-  // Draw cursor if cursor line is visible in current view
-  // Calculate cursor's absolute line number
-  int cursorLineNumber;
-  if (totalLines <= TERMINAL_BUFFER_ROWS) {
-    cursorLineNumber = cursorY;
-  } else {
-    // In circular buffer, find absolute line number of cursor
-    int newestLinePos = (totalLines - 1) % TERMINAL_BUFFER_ROWS;
-    int offset = (newestLinePos - cursorY + TERMINAL_BUFFER_ROWS) % TERMINAL_BUFFER_ROWS;
-    cursorLineNumber = totalLines - 1 - offset;
+  // When keyboard is visible, clear artifacts between the last row and the keyboard
+  if (full && keyboardVisible) {
+    int textRows = prompt ? rows + 1 : rows;
+    int clearStartY = TERMINAL_START_Y + textRows * cellHeight;
+    int clearHeight = maxY - clearStartY;
+    if (clearHeight > 0) {
+      renderFill(0, clearStartY, SCREEN_WIDTH, clearHeight, terminalPalette[CELL_DEFAULT_BG]);
+    }
+    memset(&glassLength[clearStartY], 0, SCREEN_HEIGHT - clearStartY);
   }
   
-  // Check if cursor line is in visible range
-  // When keyboard is visible, we show 5 rows but allow cursor on 6th row (line index 5)
-  int maxCursorLine = firstLineToShow + visibleRows;  // Allow one extra line for cursor
-  if (cursorLineNumber >= firstLineToShow && cursorLineNumber <= maxCursorLine) {
-    int screenY = TERMINAL_START_Y + (cursorLineNumber - firstLineToShow) * 8;
-    // Allow cursor even if line touches bottom boundary
-    if (screenY < maxY) {
-      // Draw cursor at calculated position
-      int screenX = cursorX * 6;
-      tft.fillRect(screenX, screenY + 7, 6, 1, fgColor);
+  if (scrollbarChanged) {
+    // Clear scrollbar area first (before deciding whether to draw it)
+    const int scrollbarX = SCREEN_WIDTH - 4;
+    const int scrollbarWidth = 3;
+    renderFill(scrollbarX, TERMINAL_START_Y, scrollbarWidth, maxY - TERMINAL_START_Y, terminalPalette[CELL_DEFAULT_BG]);
+    
+    // Draw scrollbar if there's content to scroll (AFTER clearing area)
+    if (historyLines() > visibleRows) {
+      drawScrollbar(maxY);
     }
   }
+  
+  // Draw cursor if it moved or its cell was repainted
+  if (cursorRow >= 0 && cursorBlinkOn && (cursorMoved || cursorRowPainted)) {
+    drawCursor(cursorRow, cursorX, rowShift);
+  }
+  rendererEndFrame();
+  
+  // Remember what is on screen now. Rows below the text may be covered by
+  // the keyboard or the search prompt.
+  for (int y = rows; y <= TERMINAL_MAX_ROWS; y++) {
+    shownLine[y] = NO_LINE;
+    shownPending[y] = false;
+    shownValid[y] = false;
+  }
+  shownRows = rows;
+  shownMaxY = maxY;
+  shownCursorRow = cursorRow;
+  shownCursorX = cursorX;
+  shownCursorShape = cursorShape;
+  shownCursorDrawn = cursorRow >= 0 && cursorBlinkOn;
+  shownTotalLines = totalLines;
+  shownOldestLine = oldestLine();
+  shownScrollOffset = scrollOffset;
+  shownRowShift = rowShift;
+  shownScrollPixel = scrollPixel;
+  
+  memset(dirtyFrom, 0, sizeof(dirtyFrom));
+  memset(dirtyTo, 0, sizeof(dirtyTo));
+  fullDamage = false;
+  
+  // Frame stats
+  renderStats.frames++;
+  renderStats.lastFrameUs = micros() - frameStart;
+  renderStats.lastRows = rowsPainted;
+  renderStats.lastCells = frameCells;
+  renderStats.lastBytes = frameBytes;
+  renderStats.totalRows += rowsPainted;
+  renderStats.totalCells += frameCells;
+  renderStats.totalBytes += frameBytes;
+  
+  return true;
 }
 
-void drawCursor(bool visible) {
-  int screenX = cursorX * 6;
-  int screenY = TERMINAL_START_Y + cursorY * 8;
+void terminalRedraw() {
+  // Check every row right away, regardless of the frame cap
+  renderFrame(true);
+  lastFrameTime = millis();
+}
+
+void terminalInvalidate() {
+  // Pixels are unknown: every cell is pushed again, blanks included
+  memset(glassLength, terminalCols, sizeof(glassLength));
+  memset(shownValid, 0, sizeof(shownValid));
+  shownCursorRow = -1;
+  shownCursorDrawn = false;
+  markAllDirty();
+}
+
+bool terminalBlinkCursor() {
+  if (!(cursorShape & 1) || millis() - cursorBlinkTime < CURSOR_BLINK_MS) return false;
+  cursorBlinkTime = millis();
+  cursorBlinkOn = !cursorBlinkOn;
   
-  if (visible) {
-    tft.fillRect(screenX, screenY + 7, 6, 1, fgColor);
+  // Only the cursor cell on the glass changes. If the cursor moved since,
+  // the next frame takes it there.
+  if (shownCursorRow < 0 || !shownValid[shownCursorRow] || shownCursorDrawn == cursorBlinkOn) return false;
+  int row = shownCursorRow;
+  int x = shownCursorX;
+  frameCells = 0;
+  frameBytes = 0;
+  rendererBeginFrame();
+  if (cursorBlinkOn) {
+    drawCursor(row, x, shownRowShift);
   } else {
-    tft.fillRect(screenX, screenY + 7, 6, 1, bgColor);
+    // Put back the pixels of the cell under the cursor
+    paintRow(shownCells[row], TERMINAL_START_Y + row * cellHeight + shownRowShift, x, x + 1);
   }
+  rendererEndFrame();
+  shownCursorDrawn = cursorBlinkOn;
+  
+  renderStats.blinkCells += frameCells;
+  renderStats.blinkBytes += frameBytes;
+  return true;
+}
+
+bool terminalRender(bool idle) {
+  // A running search advances every call, whether or not a frame is due
+  if (searchDirection != 0) searchStep();
+  
+  // Cap the frame rate while data keeps coming, paint at once when idle
+  if (!idle && millis() - lastFrameTime < 1000 / RENDER_FPS_MAX) {
+    return false;
+  }
+  
+  if (!renderFrame(false)) return false;
+  lastFrameTime = millis();
+  return true;
+}
+
+void terminalGetRenderStats(TerminalRenderStats* stats) {
+  *stats = renderStats;
+}
+
+void terminalResetRenderStats() {
+  memset(&renderStats, 0, sizeof(renderStats));
 }
 
 void ensureCursorVisible() {
   extern bool keyboardVisible;
+  if (searchMatchLine >= 0) {
+    // Keep the search match in view while new lines arrive. Rows stay on
+    // the same line numbers, so a line edited and pushed to history before
+    // it was drawn relies on scrollUp() invalidating its screen row.
+    scrollOffset += totalLines - searchTotalLines;
+    searchTotalLines = totalLines;
+    int maxScroll = historyLines() - visibleRowCount();
+    if (scrollOffset > maxScroll) scrollOffset = maxScroll > 0 ? maxScroll : 0;
+    return;
+  }
+  
   if (!keyboardVisible) {
     // Keyboard not visible - reset to bottom
-    if (scrollOffset != 0) {
-      scrollOffset = 0;
-      terminalRedraw();
-    }
+    scrollOffset = 0;
+    stopPixelScroll();
     return;
   }
   
   // Calculate how many rows are actually visible with keyboard
-  int visibleRows = (KEYBOARD_Y_POS - TERMINAL_START_Y) / 8;
+  int visibleRows = (KEYBOARD_Y_POS - TERMINAL_START_Y) / cellHeight;
   
   // Show only 5 rows when keyboard is visible to ensure cursor line (6th) is fully visible and higher
   if (visibleRows > 5) {
@@ -243,11 +802,11 @@ void ensureCursorVisible() {
   
   // Calculate absolute line number of cursor
   int cursorAbsoluteLine;
-  if (totalLines <= TERMINAL_BUFFER_ROWS) {
+  if (totalLines <= terminalRows) {
     cursorAbsoluteLine = cursorY;
   } else {
-    int newestLinePos = (totalLines - 1) % TERMINAL_BUFFER_ROWS;
-    int offset = (newestLinePos - cursorY + TERMINAL_BUFFER_ROWS) % TERMINAL_BUFFER_ROWS;
+    int newestLinePos = (totalLines - 1) % terminalRows;
+    int offset = (newestLinePos - cursorY + terminalRows) % terminalRows;
     cursorAbsoluteLine = totalLines - 1 - offset;
   }
   
@@ -274,341 +833,438 @@ void ensureCursorVisible() {
   
   // Always update
   scrollOffset = newScrollOffset;
-  terminalRedraw();
 }
 
 void scrollUp() {
   // In circular buffer mode, we don't move lines
   // Just increment totalLines and move cursor to the new line position
   
-  // Clear the line we're about to write to (which was the oldest line)
-  int nextLine = totalLines % TERMINAL_BUFFER_ROWS;
-  for (int x = 0; x < TERMINAL_COLS; x++) {
-    screenBuffer[nextLine][x] = ' ';
+  // The oldest live line moves to scrollback, its row is reused
+  int nextLine = totalLines % terminalRows;
+  
+  // History rows are taken as painted in their final state, so damage not
+  // yet drawn (a skipped frame) goes to the screen row showing the line
+  if (dirtyFrom[nextLine] < dirtyTo[nextLine]) {
+    int outgoingLine = totalLines - terminalRows;
+    for (int y = 0; y < shownRows; y++) {
+      if (shownLine[y] == outgoingLine) shownValid[y] = false;
+    }
   }
+  reflowPushRow(screenBuffer[nextLine], terminalCols, rowWrapped[nextLine]);
+  eraseCells(screenBuffer[nextLine], terminalCols);
+  rowWrapped[nextLine] = false;
+  markDirty(nextLine, 0, terminalCols);
   
   // Move cursor to the new line position in the circular buffer
   cursorY = nextLine;
   totalLines++;
   
-  // Don't redraw here - caller will handle it
+  // Don't redraw here - renderer picks up the damage
 }
 
-void putChar(uint32_t codepoint) {
-  if (codepoint == '\r') {
-    cursorX = 0;
-  } else if (codepoint == '\n') {
-    cursorX = 0;  // Reset to start of line first
-    cursorY++;
-    
-    // Clear the new line we just moved to
-    if (cursorY < TERMINAL_BUFFER_ROWS) {
-      for (int x = 0; x < TERMINAL_COLS; x++) {
-        screenBuffer[cursorY][x] = ' ';
-      }
-    }
-    
-    // Update totalLines to reflect actual content INCLUDING the new cursor line
-    if (totalLines < TERMINAL_BUFFER_ROWS) {
-      // Buffer not full yet, totalLines = number of lines including cursor line
+// Move cursor down one line. On the newest line this adds a line, once
+// the live screen is full its oldest line goes to scrollback.
+static void lineFeed() {
+  cursorY++;
+  
+  if (totalLines < terminalRows) {
+    // Live screen not full yet - rows map to line numbers directly
+    if (cursorY < terminalRows) {
+      eraseCells(screenBuffer[cursorY], terminalCols);
+      rowWrapped[cursorY] = false;
+      markDirty(cursorY, 0, terminalCols);
       if (cursorY >= totalLines) {
         totalLines = cursorY + 1;  // +1 to include the cursor line
       }
-    }
-    
-    // Check if we need to scroll
-    if (cursorY >= TERMINAL_BUFFER_ROWS) {
-      cursorY = TERMINAL_BUFFER_ROWS - 1; // Will be updated in scrollUp
-      scrollUp(); // This clears next line, moves cursor, and increments totalLines
-      
-      // After scrollUp, ensure cursor is visible
-      ensureCursorVisible();
-      
-      // If no keyboard, just redraw
-      extern bool keyboardVisible;
-      if (!keyboardVisible) {
-        terminalRedraw();
-      }
-    } else {
-      // Just moved to a new line
-      // Ensure cursor stays visible if keyboard is open
       ensureCursorVisible();
-      
-      // If no keyboard, just redraw
-      extern bool keyboardVisible;
-      if (!keyboardVisible) {
-        terminalRedraw();
-      }
+      return;
     }
+    totalLines = terminalRows;
+  } else if (cursorY % terminalRows != totalLines % terminalRows) {
+    // Cursor is above the newest line - clear the next one
+    cursorY %= terminalRows;
+    eraseCells(screenBuffer[cursorY], terminalCols);
+    rowWrapped[cursorY] = false;
+    markDirty(cursorY, 0, terminalCols);
+    ensureCursorVisible();
+    return;
+  }
+  
+  scrollUp(); // This clears next line, moves cursor, and increments totalLines
+  ensureCursorVisible();
+}
+
+// Move cursor to the start of the next line after the right margin was
+// reached, the row continues there
+static void wrapLine() {
+  rowWrapped[cursorY] = true;
+  cursorX = 0;
+  lineFeed();
+}
+
+void putChar(uint32_t codepoint) {
+  if (codepoint == '\r') {
+    cursorX = 0;
+  } else if (codepoint == '\n') {
+    cursorX = 0;  // Reset to start of line first
+    lineFeed();
   } else if (codepoint == '\b') {
     if (cursorX > 0) {
       cursorX--;
-      screenBuffer[cursorY][cursorX] = ' ';
-      
-      // Redraw character if cursor line is visible
-      extern bool keyboardVisible;
-      int maxY = keyboardVisible ? KEYBOARD_Y_POS : SCREEN_HEIGHT;
-      int visibleRows = (maxY - TERMINAL_START_Y) / 8;
-      if (visibleRows > TERMINAL_ROWS) visibleRows = TERMINAL_ROWS;
-      
-      // Show only 5 rows when keyboard is visible
-      if (keyboardVisible && visibleRows > 5) {
-        visibleRows = 5;
-      }
-      
-      // Calculate cursor's absolute line number
-      int cursorLineNumber;
-      if (totalLines <= TERMINAL_BUFFER_ROWS) {
-        cursorLineNumber = cursorY;
-      } else {
-        int newestLinePos = (totalLines - 1) % TERMINAL_BUFFER_ROWS;
-        int offset = (newestLinePos - cursorY + TERMINAL_BUFFER_ROWS) % TERMINAL_BUFFER_ROWS;
-        cursorLineNumber = totalLines - 1 - offset;
-      }
-      
-      int firstLineToShow = totalLines - visibleRows - scrollOffset;
-      if (firstLineToShow < 0) firstLineToShow = 0;
-      
-      // Allow cursor line to be drawn beyond visibleRows
-      if (cursorLineNumber >= firstLineToShow && cursorLineNumber <= firstLineToShow + visibleRows) {
-        int screenY = TERMINAL_START_Y + (cursorLineNumber - firstLineToShow) * 8;
-        if (screenY < maxY) {
-          drawUnicodeChar(' ', cursorX * 6, screenY, fgColor, bgColor, 1);
-        }
-      }
+      eraseCells(&screenBuffer[cursorY][cursorX], 1);
+      markDirty(cursorY, cursorX, cursorX + 1);
     }
   } else if (codepoint >= 32) {
     // Printable character (ASCII or Unicode)
-    screenBuffer[cursorY][cursorX] = codepoint;
+    TermCell& cell = screenBuffer[cursorY][cursorX];
+    cell.glyph = unicodeToFontIndex(codepoint) | currentAttr;
+    cell.colors = currentColors;
+    markDirty(cursorY, cursorX, cursorX + 1);
     
-    // Draw character if cursor line is visible
-    extern bool keyboardVisible;
-    int maxY = keyboardVisible ? KEYBOARD_Y_POS : SCREEN_HEIGHT;
-    int visibleRows = (maxY - TERMINAL_START_Y) / 8;
-    if (visibleRows > TERMINAL_ROWS) visibleRows = TERMINAL_ROWS;
+    cursorX++;
     
-    // Show only 5 rows when keyboard is visible
-    if (keyboardVisible && visibleRows > 5) {
-      visibleRows = 5;
+    if (cursorX >= terminalCols) {
+      wrapLine();
     }
+  }
+}
+
+// Fast path for a run of printable ASCII (no controls, no UTF-8):
+// one SD log append, and one cell copy plus one damage mark per row segment
+static void putAsciiRun(const uint8_t* text, int len) {
+  sdLogRXText((const char*)text, len);
+  
+  while (len > 0) {
+    // Part of the run that fits before the wrap point
+    int n = terminalCols - cursorX;
+    if (n > len) n = len;
     
-    // Calculate cursor's absolute line number
-    int cursorLineNumber;
-    if (totalLines <= TERMINAL_BUFFER_ROWS) {
-      cursorLineNumber = cursorY;
-    } else {
-      int newestLinePos = (totalLines - 1) % TERMINAL_BUFFER_ROWS;
-      int offset = (newestLinePos - cursorY + TERMINAL_BUFFER_ROWS) % TERMINAL_BUFFER_ROWS;
-      cursorLineNumber = totalLines - 1 - offset;
+    TermCell* cell = &screenBuffer[cursorY][cursorX];
+    for (int i = 0; i < n; i++) {
+      cell[i].glyph = text[i] | currentAttr;
+      cell[i].colors = currentColors;
     }
     
-    // Calculate first line shown
-    int firstLineToShow = totalLines - visibleRows - scrollOffset;
-    if (firstLineToShow < 0) firstLineToShow = 0;
-    
-    // Check if cursor line is visible (allow cursor line to be drawn beyond visibleRows)
-    // We show 5 rows, but cursor can be on 6th row (index 5)
-    if (cursorLineNumber >= firstLineToShow && cursorLineNumber <= firstLineToShow + visibleRows) {
-      int screenY = TERMINAL_START_Y + (cursorLineNumber - firstLineToShow) * 8;
-      if (screenY < maxY) {
-        drawUnicodeChar(codepoint, cursorX * 6, screenY, fgColor, bgColor, 1);
-      }
-    }
+    markDirty(cursorY, cursorX, cursorX + n);
     
-    cursorX++;
+    cursorX += n;
+    text += n;
+    len -= n;
     
-    // After moving cursor, ensure it's still visible when keyboard is open
-    extern bool keyboardVisible;
-    if (keyboardVisible) {
-      terminalRedraw();  // Redraw to show cursor at new position
+    if (cursorX >= terminalCols) {
+      wrapLine();
+    }
+  }
+}
+
+// Length of the run of plain printable ASCII (0x20-0x7E) at the start of data.
+// Checks a 32-bit word at a time: stops at controls, ESC, DEL and UTF-8 bytes.
+static int printableRunLength(const uint8_t* data, int len) {
+  int i = 0;
+  while (i + 4 <= len) {
+    uint32_t w;
+    memcpy(&w, data + i, 4);
+    uint32_t high = w & 0x80808080u;                          // >= 0x80
+    uint32_t below = (w - 0x20202020u) & ~w & 0x80808080u;    // < 0x20
+    uint32_t del = w ^ 0x7F7F7F7Fu;
+    uint32_t isDel = (del - 0x01010101u) & ~del & 0x80808080u; // == 0x7F
+    if (high | below | isDel) break;
+    i += 4;
+  }
+  while (i < len && data[i] >= 0x20 && data[i] < 0x7F) {
+    i++;
+  }
+  return i;
+}
+
+// DEC Special Graphics (line drawing) for 0x5F-0x7E when G0 is set to '0'
+static const uint16_t decSpecialGraphics[32] = {
+  0x00A0, 0x25C6, 0x2592, 0x2409, 0x240C, 0x240D, 0x240A, 0x00B0,  // _ ` a b c d e f
+  0x00B1, 0x2424, 0x240B, 0x2518, 0x2510, 0x250C, 0x2514, 0x253C,  // g h i j k l m n
+  0x23BA, 0x23BB, 0x2500, 0x23BC, 0x23BD, 0x251C, 0x2524, 0x2534,  // o p q r s t u v
+  0x252C, 0x2502, 0x2264, 0x2265, 0x03C0, 0x2260, 0x00A3, 0x00B7   // w x y z { | } ~
+};
+
+// Printable byte from the parser - decode UTF-8 and put on screen
+static void vtPrint(uint8_t byte) {
+  if (!utf8Decode(&utf8Decoder, byte)) return;
+  
+  uint32_t codepoint = utf8GetCodepoint(&utf8Decoder);
+  utf8Init(&utf8Decoder); // Reset for next character
+  
+  if (singleShiftPending) {
+    // G2/G3 are not mapped - drop the shifted character
+    singleShiftPending = false;
+    return;
+  }
+  
+  if (g0LineDrawing && codepoint >= 0x5F && codepoint <= 0x7E) {
+    codepoint = decSpecialGraphics[codepoint - 0x5F];
+  }
+  
+  // Log to SD after successful UTF-8 decoding
+  sdLogRXCodepoint(codepoint);
+  
+  putChar(codepoint);
+}
+
+// C0 control character
+static void vtExecute(uint8_t byte) {
+  // Control character interrupts any pending UTF-8 sequence
+  utf8Init(&utf8Decoder);
+  
+  switch (byte) {
+    case '\r':
+    case '\n':
+    case '\b':
+      sdLogRXCodepoint(byte);
+      putChar(byte);
+      break;
+      
+    case '\t': {
+      // Tab stops every 8 columns
+      int nextStop = (cursorX / 8 + 1) * 8;
+      if (nextStop > terminalCols - 1) nextStop = terminalCols - 1;
+      cursorX = nextStop;
+      break;
     }
     
-    if (cursorX >= TERMINAL_COLS) {
-      cursorX = 0;
-      cursorY++;
+    default:
+      // BEL and other controls are ignored
+      break;
+  }
+}
+
+static void vtEscDispatch(const VTParser* parser, uint8_t finalByte) {
+  if (parser->intermediateCount == 1 && parser->intermediates[0] == '(') {
+    // G0 character set designation
+    g0LineDrawing = (finalByte == '0');
+    return;
+  }
+  if (parser->intermediateCount > 0) {
+    // Other charset designations (G1-G3) and DEC tests are ignored
+    return;
+  }
+  
+  switch (finalByte) {
+    case 'c': // RIS - full reset
+      terminalReset();
+      break;
       
-      // Clear the new line we just moved to
-      if (cursorY < TERMINAL_BUFFER_ROWS) {
-        for (int x = 0; x < TERMINAL_COLS; x++) {
-          screenBuffer[cursorY][x] = ' ';
-        }
-      }
+    case '7': // DECSC - save cursor
+      savedCursorX = cursorX;
+      savedCursorY = cursorScreenRow();
+      break;
       
-      // Update totalLines to include the new cursor line
-      if (totalLines < TERMINAL_BUFFER_ROWS) {
-        if (cursorY >= totalLines) {
-          totalLines = cursorY + 1;  // +1 to include the cursor line
-        }
-      }
+    case '8': // DECRC - restore cursor
+      cursorX = savedCursorX;
+      cursorY = liveRow(savedCursorY);
+      break;
       
-      if (cursorY >= TERMINAL_BUFFER_ROWS) {
-        cursorY = TERMINAL_BUFFER_ROWS - 1; // Will be updated in scrollUp
-        scrollUp();
-        
-        // After scrollUp, ensure cursor is visible
-        ensureCursorVisible();
-        
-        // If no keyboard, just redraw
-        extern bool keyboardVisible;
-        if (!keyboardVisible) {
-          terminalRedraw();
-        }
-      } else {
-        // Just wrapped to new line, ensure cursor stays visible
-        ensureCursorVisible();
+    case 'D': // IND - index
+      putChar('\n');
+      break;
+      
+    case 'E': // NEL - next line
+      putChar('\r');
+      putChar('\n');
+      break;
+      
+    case 'N': // SS2
+    case 'O': // SS3
+      singleShiftPending = true;
+      break;
+      
+    default:
+      // ESC = / ESC > (keypad modes), ESC \ (string terminator) etc.
+      break;
+  }
+}
+
+// DEC private modes (ESC[?...h / ESC[?...l)
+static void setPrivateMode(const VTParser* parser, bool enable) {
+  for (int i = 0; i < parser->paramCount; i++) {
+    switch (parser->params[i]) {
+      case 25: // DECTCEM - cursor visible
+        cursorVisible = enable;
+        break;
+      default:
+        break;
+    }
+  }
+}
+
+// SGR - colors are stored as palette indices in each cell
+static void setGraphicsMode(const VTParser* parser) {
+  if (parser->paramCount == 0) {
+    currentColors = CELL_DEFAULT_COLORS;
+    currentAttr = 0;
+    return;
+  }
+  
+  uint8_t fg = currentColors >> 4;
+  uint8_t bg = currentColors & 0x0F;
+  for (int i = 0; i < parser->paramCount; i++) {
+    int p = parser->params[i];
+    if (p >= 30 && p <= 37) {
+      fg = p - 30;
+    } else if (p >= 40 && p <= 47) {
+      bg = p - 40;
+    } else if (p >= 90 && p <= 97) {
+      fg = p - 90 + 8;
+    } else if (p >= 100 && p <= 107) {
+      bg = p - 100 + 8;
+    } else {
+      switch (p) {
+        case 0: // Reset
+          fg = CELL_DEFAULT_FG;
+          bg = CELL_DEFAULT_BG;
+          currentAttr = 0;
+          break;
+        case 1: currentAttr |= CELL_BOLD; break;
+        case 4: currentAttr |= CELL_UNDERLINE; break;
+        case 7: currentAttr |= CELL_INVERSE; break;
+        case 22: currentAttr &= ~CELL_BOLD; break;
+        case 24: currentAttr &= ~CELL_UNDERLINE; break;
+        case 27: currentAttr &= ~CELL_INVERSE; break;
+        case 39: fg = CELL_DEFAULT_FG; break; // Default foreground
+        case 49: bg = CELL_DEFAULT_BG; break; // Default background
       }
     }
   }
+  currentColors = (fg << 4) | bg;
 }
 
-void processEscSequence() {
-  escBuffer[escIndex] = '\0';
+static void vtCsiDispatch(const VTParser* parser, uint8_t finalByte) {
+  if (parser->privateMarker == '?') {
+    if (finalByte == 'h') setPrivateMode(parser, true);
+    else if (finalByte == 'l') setPrivateMode(parser, false);
+    return;
+  }
+  if (finalByte == 'q' && parser->privateMarker == 0 && parser->intermediateCount == 1 &&
+      parser->intermediates[0] == ' ') {
+    // DECSCUSR - cursor shape, 0 = the default one
+    int shape = vtParserParam(parser, 0, CURSOR_SHAPE);
+    if (shape <= 6) cursorShape = shape;
+    return;
+  }
+  if (parser->privateMarker != 0 || parser->intermediateCount > 0) {
+    // Secondary DA etc. - not supported
+    return;
+  }
   
-  // Parse ESC sequence
-  if (escIndex >= 2 && escBuffer[0] == '[') {
-    char cmd = escBuffer[escIndex - 1];
-    
-    // Extract parameters
-    int params[4] = {0, 0, 0, 0};
-    int paramCount = 0;
-    int num = 0;
-    bool hasNum = false;
-    
-    for (int i = 1; i < escIndex - 1; i++) {
-      if (escBuffer[i] >= '0' && escBuffer[i] <= '9') {
-        num = num * 10 + (escBuffer[i] - '0');
-        hasNum = true;
-      } else if (escBuffer[i] == ';') {
-        if (hasNum && paramCount < 4) {
-          params[paramCount++] = num;
-        }
-        num = 0;
-        hasNum = false;
+  int n = vtParserParam(parser, 0, 1);
+  
+  switch (finalByte) {
+    case 'H': // Cursor position
+    case 'f':
+      cursorX = vtParserParam(parser, 1, 1) - 1;
+      cursorX = constrain(cursorX, 0, terminalCols - 1);
+      cursorY = liveRow(constrain(vtParserParam(parser, 0, 1) - 1, 0, terminalRows - 1));
+      break;
+      
+    case 'J': // Clear screen
+      if (vtParserParam(parser, 0, 0) == 2) {
+        terminalClear();
       }
+      break;
+      
+    case 'K': { // Clear line: 0 = to end, 1 = to start, 2 = whole line
+      int mode = vtParserParam(parser, 0, 0);
+      int from = (mode == 0) ? cursorX : 0;
+      int to = (mode == 1) ? cursorX + 1 : terminalCols;
+      if (to > terminalCols) to = terminalCols;
+      eraseCells(&screenBuffer[cursorY][from], to - from);
+      markDirty(cursorY, from, to);
+      break;
     }
-    if (hasNum && paramCount < 4) {
-      params[paramCount++] = num;
+    
+    case 'm': // Graphics mode (colors and attributes)
+      setGraphicsMode(parser);
+      break;
+      
+    case 'A': { // Cursor up
+      int row = cursorScreenRow() - n;
+      cursorY = liveRow(row < 0 ? 0 : row);
+      break;
     }
     
-    // Process command
-    switch (cmd) {
-      case 'H': // Cursor position
-      case 'f':
-        cursorY = (paramCount > 0 && params[0] > 0) ? params[0] - 1 : 0;
-        cursorX = (paramCount > 1 && params[1] > 0) ? params[1] - 1 : 0;
-        cursorX = constrain(cursorX, 0, TERMINAL_COLS - 1);
-        cursorY = constrain(cursorY, 0, TERMINAL_ROWS - 1);
-        break;
-        
-      case 'J': // Clear screen
-        if (params[0] == 2) {
-          terminalClear();
-        }
-        break;
-        
-      case 'K': // Clear line
-        for (int x = cursorX; x < TERMINAL_COLS; x++) {
-          screenBuffer[cursorY][x] = ' ';
-        }
-        terminalRedraw();
-        break;
-        
-      case 'm': // Graphics mode (colors)
-        if (paramCount == 0 || params[0] == 0) {
-          // Reset
-          fgColor = TFT_GREEN;
-          bgColor = TFT_BLACK;
-        } else {
-          // Basic color support
-          for (int i = 0; i < paramCount; i++) {
-            if (params[i] >= 30 && params[i] <= 37) {
-              // Foreground color
-              switch (params[i]) {
-                case 30: fgColor = TFT_BLACK; break;
-                case 31: fgColor = TFT_RED; break;
-                case 32: fgColor = TFT_GREEN; break;
-                case 33: fgColor = TFT_YELLOW; break;
-                case 34: fgColor = TFT_BLUE; break;
-                case 35: fgColor = TFT_MAGENTA; break;
-                case 36: fgColor = TFT_CYAN; break;
-                case 37: fgColor = TFT_WHITE; break;
-              }
-            }
-          }
-        }
-        break;
-        
-      case 'A': // Cursor up
-        if (params[0] == 0) params[0] = 1;
-        cursorY -= params[0];
-        if (cursorY < 0) cursorY = 0;
-        break;
-        
-      case 'B': // Cursor down
-        if (params[0] == 0) params[0] = 1;
-        cursorY += params[0];
-        if (cursorY >= TERMINAL_ROWS) cursorY = TERMINAL_ROWS - 1;
-        break;
-        
-      case 'C': // Cursor forward
-        if (params[0] == 0) params[0] = 1;
-        cursorX += params[0];
-        if (cursorX >= TERMINAL_COLS) cursorX = TERMINAL_COLS - 1;
-        break;
-        
-      case 'D': // Cursor back
-        if (params[0] == 0) params[0] = 1;
-        cursorX -= params[0];
-        if (cursorX < 0) cursorX = 0;
-        break;
+    case 'B': { // Cursor down
+      int row = cursorScreenRow() + n;
+      cursorY = liveRow(row >= terminalRows ? terminalRows - 1 : row);
+      break;
     }
+    
+    case 'C': // Cursor forward
+      cursorX += n;
+      if (cursorX >= terminalCols) cursorX = terminalCols - 1;
+      break;
+      
+    case 'D': // Cursor back
+      cursorX -= n;
+      if (cursorX < 0) cursorX = 0;
+      break;
+      
+    case 'G': // Cursor horizontal absolute
+      cursorX = constrain(n - 1, 0, terminalCols - 1);
+      break;
+      
+    case 's': // Save cursor
+      savedCursorX = cursorX;
+      savedCursorY = cursorScreenRow();
+      break;
+      
+    case 'u': // Restore cursor
+      cursorX = savedCursorX;
+      cursorY = liveRow(savedCursorY);
+      break;
   }
-  
-  // Reset ESC state
-  inEscSequence = false;
-  escIndex = 0;
 }
 
-void terminalUpdate() {
-  if (terminalSerial && terminalSerial->available()) {
-    // Mark RX activity (external variable from main)
-    extern unsigned long lastRxTime;
-    lastRxTime = millis();
+int terminalUpdate() {
+  // Bytes are collected by the RX task, here we only consume the ring buffer
+  int available = uartIoAvailable();
+  if (available <= 0) return 0;
+  
+  // Mark RX activity (external variable from main)
+  extern unsigned long lastRxTime;
+  lastRxTime = millis();
+  
+  // Drain everything available, bounded by a byte and time budget so
+  // touch and the status bar still get serviced under sustained traffic
+  uint8_t chunk[RX_CHUNK_SIZE];
+  unsigned long batchStart = micros();
+  int processed = 0;
+  
+  while (available > 0 && processed < RX_BATCH_MAX_BYTES) {
+    int want = available;
+    if (want > (int)sizeof(chunk)) want = sizeof(chunk);
+    if (want > RX_BATCH_MAX_BYTES - processed) want = RX_BATCH_MAX_BYTES - processed;
     
-    uint8_t byte = terminalSerial->read();
+    int got = uartIoRead(chunk, want);
+    if (got <= 0) break;
     
-    if (inEscSequence) {
-      // Collecting ESC sequence
-      if (escIndex < sizeof(escBuffer) - 1) {
-        escBuffer[escIndex++] = byte;
-        
-        // Check if sequence is complete
-        if ((byte >= 'A' && byte <= 'Z') || (byte >= 'a' && byte <= 'z')) {
-          processEscSequence();
+    int i = 0;
+    while (i < got) {
+      // Plain text outside escape sequences goes through the run fast path
+      if (vtParserInGround(&vtParser) && utf8Decoder.bytesNeeded == 0 &&
+          !singleShiftPending && !g0LineDrawing) {
+        int run = printableRunLength(chunk + i, got - i);
+        if (run > 0) {
+          putAsciiRun(chunk + i, run);
+          i += run;
+          continue;
         }
-      } else {
-        // Buffer overflow, reset
-        inEscSequence = false;
-        escIndex = 0;
-      }
-    } else if (byte == 0x1B) {
-      // ESC character - start sequence
-      inEscSequence = true;
-      escIndex = 0;
-    } else {
-      // Normal character - decode UTF-8
-      if (utf8Decode(&utf8Decoder, byte)) {
-        uint32_t codepoint = utf8GetCodepoint(&utf8Decoder);
-        // Serial.printf("Received codepoint: U+%04X\n", codepoint);
-        
-        // Log to SD after successful UTF-8 decoding
-        sdLogRXCodepoint(codepoint);
-        
-        putChar(codepoint);
-        utf8Init(&utf8Decoder); // Reset for next character
       }
+      vtParserFeed(&vtParser, chunk[i++]);
     }
+    processed += got;
+    
+    if (micros() - batchStart >= RX_BATCH_MAX_US) break;
+    available = uartIoAvailable();
   }
+  
+  return processed;
 }
 
 void terminalSendText(const char* text) {
@@ -616,7 +1272,7 @@ void terminalSendText(const char* text) {
  // Serial.print(text);
  // Serial.println("'");
   
-  if (terminalSerial) {
+  if (uartIoIsOpen()) {
     // Mark TX activity (external variable from main)
     extern unsigned long lastTxTime;
     lastTxTime = millis();
@@ -625,7 +1281,7 @@ void terminalSendText(const char* text) {
     sdLogTX(text, strlen(text));
     
     // Send to UART
-    terminalSerial->print(text);
+    uartIoPrint(text);
     
     // Local echo - decode UTF-8 properly
     UTF8Decoder localDecoder;
@@ -639,13 +1295,13 @@ void terminalSendText(const char* text) {
       }
     }
   } else {
-    Serial.println("ERROR: terminalSerial is NULL!");
+    Serial.println("ERROR: UART is not open!");
   }
 }
 
 // Send text to UART without local echo (for text already displayed on screen)
 void terminalSendTextNoEcho(const char* text) {
-  if (terminalSerial) {
+  if (uartIoIsOpen()) {
     // Mark TX activity
     extern unsigned long lastTxTime;
     lastTxTime = millis();
@@ -654,9 +1310,9 @@ void terminalSendTextNoEcho(const char* text) {
     sdLogTX(text, strlen(text));
     
     // Send to UART (no local echo - text already on screen)
-    terminalSerial->print(text);
+    uartIoPrint(text);
   } else {
-    Serial.println("ERROR: terminalSerial is NULL!");
+    Serial.println("ERROR: UART is not open!");
   }
 }
 
@@ -667,17 +1323,17 @@ void terminalSendChar(char c) {
   //Serial.print(c, HEX);
   //Serial.println(")");
   
-  if (terminalSerial) {
+  if (uartIoIsOpen()) {
     // Mark TX activity (external variable from main)
     extern unsigned long lastTxTime;
     lastTxTime = millis();
     
-    terminalSerial->write(c);
+    uartIoWrite((const uint8_t*)&c, 1);
     
     // Local echo - display on CYD screen
     putChar(c);
   } else {
-    Serial.println("ERROR: terminalSerial is NULL!");
+    Serial.println("ERROR: UART is not open!");
   }
 }
 
@@ -702,25 +1358,155 @@ void terminalLocalEchoText(const char* text) {
 
 void terminalClear() {
   // Clear buffer
-  for (int y = 0; y < TERMINAL_BUFFER_ROWS; y++) {
-    for (int x = 0; x < TERMINAL_COLS; x++) {
-      screenBuffer[y][x] = ' ';
-    }
+  for (int y = 0; y < terminalRows; y++) {
+    eraseCells(screenBuffer[y], terminalCols);
   }
+  memset(rowWrapped, 0, sizeof(rowWrapped));
+  scrollbackClear();
+  reflowClear();
   cursorX = 0;
   cursorY = 0;
   scrollOffset = 0;
   totalLines = 0;
+  stopPixelScroll();
   
-  // Clear screen
-  tft.fillRect(0, TERMINAL_START_Y, SCREEN_WIDTH, SCREEN_HEIGHT - TERMINAL_START_Y, bgColor);
-  drawCursor(true);
+  // Line numbers start over
+  searchMatchLine = -1;
+  searchDirection = 0;
+  searchWaiting = false;
+  
+  // Screen is cleared by the next frame
+  markAllDirty();
 }
 
 void terminalReset() {
+  currentColors = CELL_DEFAULT_COLORS;
+  currentAttr = 0;
   terminalClear();
-  fgColor = TFT_GREEN;
-  bgColor = TFT_BLACK;
+  g0LineDrawing = false;
+  singleShiftPending = false;
+  cursorVisible = true;
+  cursorShape = CURSOR_SHAPE;
+  savedCursorX = 0;
+  savedCursorY = 0;
+}
+
+// Swap two rows of the live screen
+static void swapRows(int a, int b) {
+  TermCell row[TERMINAL_MAX_COLS];
+  memcpy(row, screenBuffer[a], sizeof(row));
+  memcpy(screenBuffer[a], screenBuffer[b], sizeof(row));
+  memcpy(screenBuffer[b], row, sizeof(row));
+  bool wrapped = rowWrapped[a];
+  rowWrapped[a] = rowWrapped[b];
+  rowWrapped[b] = wrapped;
+}
+
+static void reverseRows(int from, int to) {
+  for (to--; from < to; from++, to--) swapRows(from, to);
+}
+
+// Rotate rows [0, count) so that row first becomes row 0
+static void rotateRows(int first, int count) {
+  reverseRows(0, first);
+  reverseRows(first, count);
+  reverseRows(0, count);
+}
+
+// Blank cells in the default colors
+static void blankCells(TermCell* cells, int count) {
+  for (int x = 0; x < count; x++) {
+    cells[x].glyph = ' ';
+    cells[x].colors = CELL_DEFAULT_COLORS;
+  }
+}
+
+void terminalSetFont(int font) {
+  if (font < 0 || font >= CELL_FONT_COUNT || font == currentFont) return;
+  
+  int oldCols = terminalCols;
+  int oldRows = terminalRows;
+  int cursorLine = cursorLineNumber();
+  
+  // Live lines in line order from row 0: line first + y is in row y
+  int live = totalLines < oldRows ? totalLines : oldRows;
+  int first = totalLines - live;
+  if (totalLines > oldRows) rotateRows(totalLines % oldRows, oldRows);
+  
+  // All live lines join scrollback (keeping their numbers), then the
+  // newest rows at the new width come back out. Only the lines that end up
+  // on the live screen are rewrapped now, the rest of the history when it
+  // is shown.
+  for (int y = 0; y < live; y++) {
+    reflowPushRow(screenBuffer[y], oldCols, rowWrapped[y]);
+  }
+  setGeometry(font);
+  ReflowMark marks[2] = {
+    {(uint32_t)cursorLine, cursorX, -1},
+    {(uint32_t)(first + savedCursorY), savedCursorX, -1}
+  };
+  int taken = reflowTakeRows(screenBuffer, rowWrapped, terminalRows, marks, 2);
+  
+  // Taken rows to the top. If the history ran out they don't fill the
+  // screen, else blank lines follow the newest line.
+  int skipped = terminalRows - taken;
+  if (skipped > 0) {
+    memmove(screenBuffer[0], screenBuffer[skipped], taken * sizeof(screenBuffer[0]));
+    memmove(rowWrapped, &rowWrapped[skipped], taken * sizeof(rowWrapped[0]));
+    for (int y = taken; y < terminalRows; y++) {
+      blankCells(screenBuffer[y], TERMINAL_MAX_COLS);
+      rowWrapped[y] = false;
+    }
+  }
+  live = scrollbackEndLine() > 0 ? terminalRows : taken;
+  totalLines = scrollbackEndLine() + live;
+  
+  // Back to ring order, line n in row n % terminalRows
+  if (totalLines > terminalRows) {
+    rotateRows(terminalRows - totalLines % terminalRows, terminalRows);
+  }
+  
+  // Cursor stays where its text went, or on the top row if that was
+  // left in scrollback
+  int cursorRow = marks[0].row >= 0 ? marks[0].row - skipped : 0;
+  cursorY = liveRow(cursorRow);
+  cursorX = marks[0].row >= 0 ? marks[0].x : 0;
+  savedCursorY = marks[1].row >= 0 ? marks[1].row - skipped : 0;
+  savedCursorX = marks[1].row >= 0 ? marks[1].x : 0;
+  
+  // Line numbers changed under the search
+  searchMatchLine = -1;
+  searchDirection = 0;
+  searchWaiting = false;
+  
+  int maxScroll = terminalGetMaxScroll();
+  if (scrollOffset > maxScroll) scrollOffset = maxScroll;
+  stopPixelScroll();
+  
+  // Nothing on the glass lines up with the new grid: clear the text area
+  // and paint everything with the next frame
+  extern bool keyboardVisible;
+  int maxY = keyboardVisible ? KEYBOARD_Y_POS : SCREEN_HEIGHT;
+  rendererFillRect(0, TERMINAL_START_Y, SCREEN_WIDTH, maxY - TERMINAL_START_Y, terminalPalette[CELL_DEFAULT_BG]);
+  memset(glassLength, 0, sizeof(glassLength));
+  memset(shownValid, 0, sizeof(shownValid));
+  memset(dirtyFrom, 0, sizeof(dirtyFrom));
+  memset(dirtyTo, 0, sizeof(dirtyTo));
+  shownCursorRow = -1;
+  shownCursorDrawn = false;
+  markAllDirty();
+}
+
+int terminalGetFont() {
+  return currentFont;
+}
+
+int terminalGetCols() {
+  return terminalCols;
+}
+
+int terminalGetRows() {
+  return terminalRows;
 }
 
 void drawScrollbar(int maxY) {
@@ -730,10 +1516,10 @@ void drawScrollbar(int maxY) {
   const int scrollbarHeight = maxY - TERMINAL_START_Y;
   
   // Background track
-  tft.fillRect(scrollbarX, TERMINAL_START_Y, scrollbarWidth, scrollbarHeight, TFT_DARKGREY);
+  renderFill(scrollbarX, TERMINAL_START_Y, scrollbarWidth, scrollbarHeight, TFT_DARKGREY);
   
   // Calculate thumb position and size
-  int totalContentHeight = totalLines * 8;
+  int totalContentHeight = historyLines() * cellHeight;
   int visibleHeight = scrollbarHeight;
   
   if (totalContentHeight > visibleHeight) {
@@ -744,31 +1530,98 @@ void drawScrollbar(int maxY) {
     // Thumb position based on scroll offset
     // scrollOffset = 0 means at bottom (most recent), thumb should be at bottom
     // scrollOffset = maxScroll means at top (oldest), thumb should be at top
-    int maxScroll = totalLines - (visibleHeight / 8);
+    int maxScroll = historyLines() - (visibleHeight / cellHeight);
     if (maxScroll < 1) maxScroll = 1;
     
     int thumbRange = visibleHeight - thumbHeight;
     
     // Invert: when scrollOffset=0 (bottom), thumbY should be at bottom of track
     // when scrollOffset=maxScroll (top), thumbY should be at top of track
-    int thumbY = TERMINAL_START_Y + thumbRange - (thumbRange * scrollOffset) / maxScroll;
+    int offset = scrollOffset * cellHeight + scrollPixel;
+    if (offset > maxScroll * cellHeight) offset = maxScroll * cellHeight;
+    int thumbY = TERMINAL_START_Y + thumbRange - (thumbRange * offset) / (maxScroll * cellHeight);
     
     // Draw thumb
-    tft.fillRect(scrollbarX, thumbY, scrollbarWidth, thumbHeight, TFT_GREEN);
+    renderFill(scrollbarX, thumbY, scrollbarWidth, thumbHeight, TFT_GREEN);
   }
 }
 
-void terminalScroll(int delta) {
-  scrollOffset += delta;
+// Scroll by pixels, returns false if the scroll stopped at either end
+static bool scrollPixels(int pixels) {
+  int position = scrollOffset * cellHeight + scrollPixel + pixels;
   
   // Limit scroll range
-  int maxScroll = totalLines - TERMINAL_ROWS;
-  if (maxScroll < 0) maxScroll = 0;
+  int maxPosition = terminalGetMaxScroll() * cellHeight;
+  bool moved = true;
+  if (position < 0) {
+    position = 0;
+    moved = false;
+  }
+  if (position > maxPosition) {
+    position = maxPosition;
+    moved = false;
+  }
   
-  if (scrollOffset < 0) scrollOffset = 0;
-  if (scrollOffset > maxScroll) scrollOffset = maxScroll;
+  scrollOffset = position / cellHeight;
+  scrollPixel = position % cellHeight;
   
-  terminalRedraw();
+  // Repainted by the next terminalRender() frame
+  return moved;
+}
+
+// Back to whole-line scrolling at the current line, any fling stops
+static void stopPixelScroll() {
+  scrollPixel = 0;
+  flingVelocity = 0;
+}
+
+void terminalScroll(int delta) {
+  scrollPixels(delta * cellHeight);
+}
+
+void terminalScrollPixels(int pixels) {
+  scrollPixels(pixels);
+}
+
+void terminalFling(int pixelsPerSecond) {
+  if (pixelsPerSecond > SCROLL_FLING_MAX_VELOCITY) pixelsPerSecond = SCROLL_FLING_MAX_VELOCITY;
+  if (pixelsPerSecond < -SCROLL_FLING_MAX_VELOCITY) pixelsPerSecond = -SCROLL_FLING_MAX_VELOCITY;
+  if (abs(pixelsPerSecond) < SCROLL_FLING_MIN_VELOCITY) pixelsPerSecond = 0;
+  
+  flingVelocity = pixelsPerSecond;
+  flingRemainder = 0;
+  flingLastUpdate = millis();
+}
+
+void terminalStopFling() {
+  flingVelocity = 0;
+}
+
+bool terminalUpdateFling() {
+  if (flingVelocity == 0) return false;
+  
+  // Advance by the time since the last update, so the fling speed doesn't
+  // depend on how often the loop gets here
+  unsigned long now = millis();
+  float dt = (now - flingLastUpdate) / 1000.0f;
+  flingLastUpdate = now;
+  
+  float distance = flingVelocity * dt + flingRemainder;
+  int pixels = (int)distance;
+  flingRemainder = distance - pixels;
+  if (pixels != 0 && !scrollPixels(pixels)) {
+    flingVelocity = 0;
+    return false;
+  }
+  
+  // Decelerate
+  float speed = fabsf(flingVelocity) - SCROLL_FLING_DECEL * dt;
+  if (speed < SCROLL_FLING_MIN_VELOCITY) {
+    flingVelocity = 0;
+    return false;
+  }
+  flingVelocity = flingVelocity > 0 ? speed : -speed;
+  return true;
 }
 
 int terminalGetScrollOffset() {
@@ -776,13 +1629,13 @@ int terminalGetScrollOffset() {
 }
 
 int terminalGetMaxScroll() {
-  int maxScroll = totalLines - TERMINAL_ROWS;
+  int maxScroll = historyLines() - terminalRows;
   return maxScroll > 0 ? maxScroll : 0;
 }
 
 void terminalScrollToBottom() {
   scrollOffset = 0;
-  terminalRedraw();
+  stopPixelScroll();
 }
 
 int terminalGetCursorY() {
@@ -793,21 +1646,21 @@ void terminalScrollForKeyboard(bool keyboardVisible) {
   if (keyboardVisible) {
     // Клавиатура открывается
     // Рассчитываем сколько строк видно с клавиатурой
-    int visibleRows = (KEYBOARD_Y_POS - TERMINAL_START_Y) / 8;
+    int visibleRows = (KEYBOARD_Y_POS - TERMINAL_START_Y) / cellHeight;
     
     // Вычисляем абсолютный номер строки курсора в истории
     int cursorAbsoluteLine;
-    if (totalLines <= TERMINAL_BUFFER_ROWS) {
+    if (totalLines <= terminalRows) {
       // Буфер еще не заполнен, прямое соответствие
       cursorAbsoluteLine = cursorY;
     } else {
       // Буфер циклический
       // Самая новая строка имеет абсолютный номер totalLines - 1
-      // Она находится в позиции (totalLines - 1) % TERMINAL_BUFFER_ROWS
-      int newestLinePos = (totalLines - 1) % TERMINAL_BUFFER_ROWS;
+      // Она находится в позиции (totalLines - 1) % terminalRows
+      int newestLinePos = (totalLines - 1) % terminalRows;
       
       // Смещение от самой новой строки до курсора (в кольцевом буфере)
-      int offset = (newestLinePos - cursorY + TERMINAL_BUFFER_ROWS) % TERMINAL_BUFFER_ROWS;
+      int offset = (newestLinePos - cursorY + terminalRows) % terminalRows;
       
       // Абсолютная позиция курсора
       cursorAbsoluteLine = totalLines - 1 - offset;
@@ -830,6 +1683,191 @@ void terminalScrollForKeyboard(bool keyboardVisible) {
     // Клавиатура закрывается - вернуться к низу
     scrollOffset = 0;
   }
+  stopPixelScroll();
   
   terminalRedraw();
 }
+
+// Column of the search match in count cells nearest to column from: left
+// of it towards older text (direction -1), right of it towards newer (1).
+// -1 if there is none.
+static int searchCells(const TermCell* cells, int count, int from, int direction) {
+  if (direction < 0) {
+    int x = from - 1;
+    if (x > count - searchLength) x = count - searchLength;
+    for (; x >= 0; x--) {
+      if (searchMatchesAt(cells, count, x)) return x;
+    }
+  } else {
+    for (int x = from + 1 > 0 ? from + 1 : 0; x + searchLength <= count; x++) {
+      if (searchMatchesAt(cells, count, x)) return x;
+    }
+  }
+  return -1;
+}
+
+// Column of the next search match in a line from column from (see
+// searchCells), -1 if there is none, -2 if the line's scrollback page is
+// still being read from SD
+static int searchLine(int line, int from, int direction) {
+  int bufferLine = bufferRowForLine(line);
+  if (bufferLine >= 0) {
+    return searchCells(screenBuffer[bufferLine], terminalCols, from, direction);
+  }
+  
+  // Lines whose bloom lacks a trigram of the query are skipped undecoded
+  uint64_t bloom;
+  if (!scrollbackGetLineBloom(line, &bloom)) return -2;
+  if ((bloom & searchBloom) != searchBloom) return -1;
+  
+  // Written at any width, so all of the line is searched
+  TermCell cells[TERMINAL_MAX_COLS];
+  if (!scrollbackGetLine(line, cells, TERMINAL_MAX_COLS)) return -2;
+  return searchCells(cells, TERMINAL_MAX_COLS, from, direction);
+}
+
+// Scroll so that the match is in the middle of the view
+static void searchShowMatch() {
+  // A match in scrollback is shown where its line is reflowed to. If its
+  // rows can't be read yet, the line number is close enough to scroll to.
+  searchMatchRow = searchMatchLine;
+  searchMatchColumn = searchMatchX;
+  int liveFirst = liveFirstLine();
+  uint32_t depth;
+  int column;
+  if (searchMatchLine < liveFirst && reflowFindRow(searchMatchLine, searchMatchX, &depth, &column)) {
+    searchMatchRow = liveFirst - depth;
+    searchMatchColumn = column;
+  }
+  
+  int visibleRows = visibleRowCount();
+  int firstLine = searchMatchRow - visibleRows / 2;
+  if (firstLine > totalLines - visibleRows) firstLine = totalLines - visibleRows;
+  if (firstLine < oldestLine()) firstLine = oldestLine();
+  
+  scrollOffset = totalLines - visibleRows - firstLine;
+  if (scrollOffset < 0) scrollOffset = 0;
+  searchTotalLines = totalLines;
+}
+
+static void searchStep() {
+  // Nothing to do until the page we wait for has been read
+  if (searchWaiting && scrollbackPageLoads() == searchWaitLoads) return;
+  searchWaiting = false;
+  
+  for (int n = 0; n < SEARCH_LINES_PER_STEP; n++) {
+    int line = searchNextLine;
+    if (line < oldestStoredLine() || line >= totalLines) {
+      // Ran out of history, the previous match (if any) stays current
+      searchDirection = 0;
+      searchFailed = true;
+      markAllDirty();
+      return;
+    }
+    
+    int x = searchLine(line, searchNextX, searchDirection);
+    if (x == -2) {
+      searchWaiting = true;
+      searchWaitLoads = scrollbackPageLoads();
+      return;
+    }
+    if (x >= 0) {
+      searchMatchLine = line;
+      searchMatchX = x;
+      searchDirection = 0;
+      searchFailed = false;
+      searchShowMatch();
+      markAllDirty();
+      return;
+    }
+    // Lines after the first are searched from their end towards older
+    // text, from their start towards newer
+    searchNextLine += searchDirection;
+    searchNextX = searchDirection < 0 ? TERMINAL_MAX_COLS : -1;
+  }
+}
+
+// Start walking from column x of a line (exclusive) towards older (-1) or
+// newer (1) text
+static void searchFrom(int line, int x, int direction) {
+  searchNextLine = line;
+  searchNextX = x;
+  searchDirection = direction;
+  searchFailed = false;
+  searchWaiting = false;
+  markAllDirty();
+}
+
+void terminalSearchStart() {
+  searchActive = true;
+  searchLength = 0;
+  searchMatchLine = -1;
+  searchDirection = 0;
+  searchFailed = false;
+  markAllDirty();
+}
+
+void terminalSearchStop() {
+  searchActive = false;
+  searchLength = 0;
+  searchMatchLine = -1;
+  searchDirection = 0;
+  searchWaiting = false;
+  markAllDirty();
+}
+
+bool terminalSearchActive() {
+  return searchActive;
+}
+
+void terminalSearchSetQuery(const char* query) {
+  if (!searchActive) return;
+  
+  // Query as font indices, like the cells it is compared with
+  UTF8Decoder decoder;
+  utf8Init(&decoder);
+  searchLength = 0;
+  for (const uint8_t* p = (const uint8_t*)query; *p && searchLength < SEARCH_MAX_QUERY; p++) {
+    if (!utf8Decode(&decoder, *p)) continue;
+    searchText[searchLength++] = unicodeToFontIndex(utf8GetCodepoint(&decoder));
+    utf8Init(&decoder);
+  }
+  
+  uint16_t folded[SEARCH_MAX_QUERY];
+  for (int i = 0; i < searchLength; i++) {
+    folded[i] = fontIndexFoldCase(searchText[i]);
+  }
+  searchBloom = scrollbackTrigramBloom(folded, searchLength);
+  
+  // Typing refines the search: look again from the current match (which
+  // may still match) or the end of the newest line towards older text
+  int fromLine = totalLines - 1;
+  int fromX = TERMINAL_MAX_COLS;
+  if (searchMatchLine >= 0) {
+    fromLine = searchMatchLine;
+    fromX = searchMatchX + 1;
+  }
+  searchMatchLine = -1;
+  if (searchLength == 0) {
+    searchDirection = 0;
+    searchFailed = false;
+    markAllDirty();
+    return;
+  }
+  searchFrom(fromLine, fromX, -1);
+}
+
+void terminalSearchNext(bool older) {
+  if (!searchActive || searchLength == 0) return;
+  
+  // From the current match, the next one may be on the same line. Without
+  // one, older matches are looked for from the end of the newest line and
+  // newer ones from the start of the oldest held line.
+  if (searchMatchLine >= 0) {
+    searchFrom(searchMatchLine, searchMatchX, older ? -1 : 1);
+  } else if (older) {
+    searchFrom(totalLines - 1, TERMINAL_MAX_COLS, -1);
+  } else {
+    searchFrom(oldestStoredLine(), -1, 1);
+  }
+}
@@ -8,11 +8,26 @@
 #include <Arduino.h>
 #include "config.h"
 
-// Terminal initialization
-void terminalInit(int baudRateIndex, int mode);
+// Repaint statistics
+struct TerminalRenderStats {
+  uint32_t frames;       // Frames painted
+  uint32_t lastFrameUs;  // Time spent painting the last frame
+  uint16_t lastRows;     // Screen rows (fully or partly) repainted in the last frame
+  uint16_t lastCells;    // Character cells drawn in the last frame
+  uint32_t lastBytes;    // Pixel bytes pushed to the display in the last frame
+  uint32_t totalRows;
+  uint32_t totalCells;
+  uint32_t totalBytes;
+  uint32_t blinkCells;   // Cells drawn by cursor blinks
+  uint32_t blinkBytes;   // Pixel bytes pushed by cursor blinks
+};
 
-// Terminal update loop
-void terminalUpdate();
+// Terminal initialization, font is a cell font (CELL_FONT_*)
+void terminalInit(int baudRateIndex, int mode, int font);
+
+// Terminal update loop - drains pending UART data in one batch,
+// returns number of bytes processed
+int terminalUpdate();
 
 // Send text to UART
 void terminalSendText(const char* text);
@@ -28,7 +43,28 @@ void terminalLocalEchoText(const char* text);
 // Terminal control
 void terminalClear();
 void terminalReset();
-void terminalRedraw();
+void terminalRedraw(); // Repaint every cell that changed now
+void terminalInvalidate(); // Text area was painted over: repaint every cell
+
+// Renderer - flush screen damage left by the parser. Frames are capped at
+// RENDER_FPS_MAX unless idle is true. Returns true if a frame was painted.
+bool terminalRender(bool idle);
+void terminalGetRenderStats(TerminalRenderStats* stats);
+void terminalResetRenderStats();
+
+// Cursor blink, call from the main loop. When a blink phase is over it
+// draws or removes the cursor over its cell only (never repaints a row).
+// Returns true if it drew anything.
+bool terminalBlinkCursor();
+
+// Cell font (CELL_FONT_*) and the grid it gives. Switching keeps the text
+// and rewraps soft-wrapped lines to the new width: the live screen at once,
+// scrollback when it is shown. The text area is cleared and repainted by
+// the next frame.
+void terminalSetFont(int font);
+int terminalGetFont();
+int terminalGetCols();
+int terminalGetRows();
 
 // Scroll control
 void terminalScroll(int delta); // delta > 0 = scroll up (back in history), delta < 0 = scroll down
@@ -36,9 +72,27 @@ int terminalGetScrollOffset();
 int terminalGetMaxScroll();
 void terminalScrollToBottom();
 
+// Pixel scrolling and fling (keyboard hidden). A fling keeps scrolling after
+// the finger lifts and slows down by SCROLL_FLING_DECEL; terminalUpdateFling()
+// advances it and returns true while it is still moving.
+void terminalScrollPixels(int pixels);       // pixels > 0 = back in history
+void terminalFling(int pixelsPerSecond);
+void terminalStopFling();
+bool terminalUpdateFling();
+
 // Scroll control for keyboard visibility
 void terminalScrollForKeyboard(bool keyboardVisible);
 
+// Scrollback search (case-insensitive) over the live screen and all held
+// scrollback. Matches on screen are highlighted and a prompt row shows the
+// query above the keyboard. The search runs in steps from terminalRender().
+void terminalSearchStart();
+void terminalSearchStop();
+bool terminalSearchActive();
+void terminalSearchSetQuery(const char* query);  // UTF-8, looks from the current match towards older lines
+void terminalSearchNext(bool older);             // Previous (older) or next (newer) match, also within a line;
+                                                 // newer with no match starts at the oldest held line
+
 // Get cursor position
 int terminalGetCursorY();
 
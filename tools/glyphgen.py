@@ -0,0 +1,805 @@
+#!/usr/bin/env python3
+"""
+glyphgen.py - Generate glyphatlas.h, the terminal glyph atlas
+
+The atlas holds a codepoint range table sorted by codepoint and, for each
+cell font, one bitmap per font index (one column byte per pixel column,
+LSB at top). Font indices are assigned in codepoint order, so the table is
+sorted by index as well and both directions of the mapping are one range
+search. All cell fonts cover the same font indices.
+
+Box drawing glyphs are not drawn by hand: their strokes are derived from
+the Unicode character names and scaled to each cell size. Box drawing and
+block elements are also written to glyphshapes.h as lists of filled
+rectangles, which the renderer draws directly instead of going through
+the bitmap.
+
+Usage: python3 tools/glyphgen.py [--preview [6x8|4x6]]
+"""
+
+import os
+import sys
+import unicodedata
+
+# Codepoint ranges covered by the atlas, in codepoint order.
+# Upper and lower case of a letter must stay in the same range
+# (fontIndexFoldCase() relies on it).
+RANGES = [
+    (0x0000, 0x007F),  # ASCII (control codes are blank)
+    (0x00A0, 0x00FF),  # Latin-1 Supplement
+    (0x0400, 0x045F),  # Cyrillic incl. Ukrainian, Belarusian, Serbian
+    (0x0490, 0x0491),  # Ґ ґ
+    (0x2500, 0x259F),  # Box drawing, block elements
+]
+
+# Codepoints drawn from rectangles (glyphshapes.h), must be one atlas range
+SHAPES = (0x2500, 0x259F)
+
+# Cell fonts (name, width, height), in the order of CELL_FONT_* in utf8.h
+FONTS = [("6x8", 6, 8), ("4x6", 4, 6)]
+
+# Range table size, padded to a power of two for the branchless search
+RANGE_TABLE_SIZE = 8
+
+# Classic 5x7 GLCD font, printable ASCII (same glyphs as TFT_eSPI font 1)
+ASCII = {
+    0x20: "00 00 00 00 00", 0x21: "00 00 5F 00 00", 0x22: "00 07 00 07 00", 0x23: "14 7F 14 7F 14",
+    0x24: "24 2A 7F 2A 12", 0x25: "23 13 08 64 62", 0x26: "36 49 56 20 50", 0x27: "00 08 07 03 00",
+    0x28: "00 1C 22 41 00", 0x29: "00 41 22 1C 00", 0x2A: "2A 1C 7F 1C 2A", 0x2B: "08 08 3E 08 08",
+    0x2C: "00 80 70 30 00", 0x2D: "08 08 08 08 08", 0x2E: "00 00 60 60 00", 0x2F: "20 10 08 04 02",
+    0x30: "3E 51 49 45 3E", 0x31: "00 42 7F 40 00", 0x32: "72 49 49 49 46", 0x33: "21 41 49 4D 33",
+    0x34: "18 14 12 7F 10", 0x35: "27 45 45 45 39", 0x36: "3C 4A 49 49 31", 0x37: "41 21 11 09 07",
+    0x38: "36 49 49 49 36", 0x39: "46 49 49 29 1E", 0x3A: "00 00 14 00 00", 0x3B: "00 40 34 00 00",
+    0x3C: "00 08 14 22 41", 0x3D: "14 14 14 14 14", 0x3E: "00 41 22 14 08", 0x3F: "02 01 59 09 06",
+    0x40: "3E 41 5D 59 4E", 0x41: "7C 12 11 12 7C", 0x42: "7F 49 49 49 36", 0x43: "3E 41 41 41 22",
+    0x44: "7F 41 41 41 3E", 0x45: "7F 49 49 49 41", 0x46: "7F 09 09 09 01", 0x47: "3E 41 41 51 73",
+    0x48: "7F 08 08 08 7F", 0x49: "00 41 7F 41 00", 0x4A: "20 40 41 3F 01", 0x4B: "7F 08 14 22 41",
+    0x4C: "7F 40 40 40 40", 0x4D: "7F 02 1C 02 7F", 0x4E: "7F 04 08 10 7F", 0x4F: "3E 41 41 41 3E",
+    0x50: "7F 09 09 09 06", 0x51: "3E 41 51 21 5E", 0x52: "7F 09 19 29 46", 0x53: "26 49 49 49 32",
+    0x54: "03 01 7F 01 03", 0x55: "3F 40 40 40 3F", 0x56: "1F 20 40 20 1F", 0x57: "3F 40 38 40 3F",
+    0x58: "63 14 08 14 63", 0x59: "03 04 78 04 03", 0x5A: "61 59 49 4D 43", 0x5B: "00 7F 41 41 41",
+    0x5C: "02 04 08 10 20", 0x5D: "00 41 41 41 7F", 0x5E: "04 02 01 02 04", 0x5F: "40 40 40 40 40",
+    0x60: "00 03 07 08 00", 0x61: "20 54 54 78 40", 0x62: "7F 28 44 44 38", 0x63: "38 44 44 44 28",
+    0x64: "38 44 44 28 7F", 0x65: "38 54 54 54 18", 0x66: "00 08 7E 09 02", 0x67: "18 A4 A4 9C 78",
+    0x68: "7F 08 04 04 78", 0x69: "00 44 7D 40 00", 0x6A: "20 40 40 3D 00", 0x6B: "7F 10 28 44 00",
+    0x6C: "00 41 7F 40 00", 0x6D: "7C 04 78 04 78", 0x6E: "7C 08 04 04 78", 0x6F: "38 44 44 44 38",
+    0x70: "FC 18 24 24 18", 0x71: "18 24 24 18 FC", 0x72: "7C 08 04 04 08", 0x73: "48 54 54 54 24",
+    0x74: "04 04 3F 44 24", 0x75: "3C 40 40 20 7C", 0x76: "1C 20 40 20 1C", 0x77: "3C 40 30 40 3C",
+    0x78: "44 28 10 28 44", 0x79: "4C 90 90 90 7C", 0x7A: "44 64 54 4C 44", 0x7B: "00 08 36 41 00",
+    0x7C: "00 00 77 00 00", 0x7D: "00 41 36 08 00", 0x7E: "02 01 02 04 02", 0x7F: "3C 26 23 26 3C",
+}
+
+# Russian alphabet А-я (U+0410-U+044F)
+CYRILLIC = [
+    "7C 12 11 12 7C 00", "7F 49 49 49 30 00", "7F 49 49 49 36 00", "7F 01 01 01 01 00",  # А Б В Г
+    "C0 7E 41 7F C0 00", "7F 49 49 49 41 00", "63 14 7F 14 63 00", "22 41 49 49 36 00",  # Д Е Ж З
+    "7F 20 10 08 7F 00", "7F 20 13 08 7F 00", "7F 08 14 22 41 00", "78 04 02 01 7F 00",  # И Й К Л
+    "7F 02 0C 02 7F 00", "7F 08 08 08 7F 00", "3E 41 41 41 3E 00", "7F 01 01 01 7F 00",  # М Н О П
+    "7F 09 09 09 06 00", "3E 41 41 41 22 00", "01 01 7F 01 01 00", "07 48 48 48 3F 00",  # Р С Т У
+    "0E 11 7F 11 0E 00", "63 14 08 14 63 00", "7F 40 40 7F C0 00", "07 08 08 08 7F 00",  # Ф Х Ц Ч
+    "7F 40 7F 40 7F 00", "7F 40 7F 40 FF 00", "01 7F 48 48 30 00", "7F 48 30 00 7F 00",  # Ш Щ Ъ Ы
+    "7F 48 48 48 30 00", "22 41 49 49 3E 00", "7F 08 3E 41 3E 00", "46 29 19 09 7F 00",  # Ь Э Ю Я
+    "20 54 54 54 78 00", "3C 4A 4A 4A 30 00", "7C 54 54 54 28 00", "7C 04 04 04 00 00",  # а б в г
+    "C0 78 44 7C C0 00", "38 54 54 54 18 00", "44 28 7C 28 44 00", "28 44 54 54 28 00",  # д е ж з
+    "7C 20 10 08 7C 00", "7C 20 16 08 7C 00", "7C 10 28 44 00 00", "70 08 04 04 7C 00",  # и й к л
+    "7C 04 18 04 7C 00", "7C 10 10 10 7C 00", "38 44 44 44 38 00", "7C 04 04 04 7C 00",  # м н о п
+    "FC 24 24 24 18 00", "38 44 44 44 28 00", "04 04 7C 04 04 00", "0C 50 50 50 3C 00",  # р с т у
+    "38 44 FE 44 38 00", "44 28 10 28 44 00", "7C 40 40 7C C0 00", "0C 10 10 10 7C 00",  # ф х ц ч
+    "7C 40 7C 40 7C 00", "7C 40 7C 40 FC 00", "04 7C 50 50 20 00", "7C 50 20 00 7C 00",  # ш щ ъ ы
+    "7C 50 50 50 20 00", "28 44 54 54 38 00", "7C 10 38 44 38 00", "48 34 14 14 7C 00",  # ь э ю я
+]
+
+# Accents, drawn in the two rows above lower case letters and the
+# short capitals below
+ACCENTS = {
+    "grave":  [".#...", "..#.."],
+    "acute":  ["...#.", "..#.."],
+    "circ":   ["..#..", ".#.#."],
+    "tilde":  [".##.#", "#..#."],
+    "diaer":  [".#.#.", "....."],
+    "ring":   [".###.", ".#.#."],
+    "breve":  [".#.#.", "..#.."],
+}
+
+# Capitals squeezed into rows 2-6, so an accent fits above them
+SHORT_CAPS = {
+    "A": [".###.", "#...#", "#####", "#...#", "#...#"],
+    "E": ["#####", "#....", "####.", "#....", "#####"],
+    "I": [".###.", "..#..", "..#..", "..#..", ".###."],
+    "N": ["#...#", "##..#", "#.#.#", "#..##", "#...#"],
+    "O": [".###.", "#...#", "#...#", "#...#", ".###."],
+    "U": ["#...#", "#...#", "#...#", "#...#", ".###."],
+    "Y": ["#...#", ".#.#.", "..#..", "..#..", "..#.."],
+    "Г": ["#####", "#....", "#....", "#....", "#...."],
+    "И": ["#...#", "#..##", "#.#.#", "##..#", "#...#"],
+    "К": ["#..#.", "#.#..", "##...", "#.#..", "#..#."],
+    "У": ["#...#", "#...#", ".####", "....#", ".###."],
+}
+
+# Hand drawn glyphs, 8 rows each ('#' set)
+ART = {
+    0x00A1: ["..#..", ".....", "..#..", "..#..", "..#..", "..#..", "..#..", "....."],  # ¡
+    0x00A2: [".....", "..#..", ".####", "#.#..", "#.#..", ".####", "..#..", "....."],  # ¢
+    0x00A3: ["..##.", ".#..#", ".#...", "###..", ".#...", ".#..#", "#.##.", "....."],  # £
+    0x00A4: [".....", "#...#", ".###.", ".#.#.", ".###.", "#...#", ".....", "....."],  # ¤
+    0x00A5: ["#...#", ".#.#.", "#####", "..#..", "#####", "..#..", "..#..", "....."],  # ¥
+    0x00A6: ["..#..", "..#..", "..#..", ".....", "..#..", "..#..", "..#..", "....."],  # ¦
+    0x00A7: [".###.", "#....", ".##..", "#..#.", ".##..", "...#.", "###..", "....."],  # §
+    0x00A8: [".#.#.", ".....", ".....", ".....", ".....", ".....", ".....", "....."],  # ¨
+    0x00A9: [".###.", "#...#", "#.###", "#.#.#", "#.###", "#...#", ".###.", "....."],  # ©
+    0x00AA: [".##..", "...#.", ".###.", "#..#.", ".###.", ".....", "####.", "....."],  # ª
+    0x00AB: [".....", "..#.#", ".#.#.", "#.#..", ".#.#.", "..#.#", ".....", "....."],  # «
+    0x00AC: [".....", ".....", ".....", "#####", "....#", "....#", ".....", "....."],  # ¬
+    0x00AD: [".....", ".....", ".....", "#####", ".....", ".....", ".....", "....."],  # soft hyphen
+    0x00AE: [".###.", "#...#", "#.#.#", "#.##.", "#.#.#", "#...#", ".###.", "....."],  # ®
+    0x00AF: ["#####", ".....", ".....", ".....", ".....", ".....", ".....", "....."],  # ¯
+    0x00B0: ["..#..", ".#.#.", "..#..", ".....", ".....", ".....", ".....", "....."],  # °
+    0x00B1: ["..#..", "..#..", "#####", "..#..", "..#..", ".....", "#####", "....."],  # ±
+    0x00B2: [".##..", "...#.", "..#..", ".###.", ".....", ".....", ".....", "....."],  # ²
+    0x00B3: [".###.", "..##.", "...#.", ".###.", ".....", ".....", ".....", "....."],  # ³
+    0x00B4: ["...#.", "..#..", ".....", ".....", ".....", ".....", ".....", "....."],  # ´
+    0x00B5: [".....", ".....", "#..#.", "#..#.", "#..#.", "#..#.", "###.#", "#...."],  # µ
+    0x00B6: [".####", "###.#", "###.#", ".##.#", "..#.#", "..#.#", "..#.#", "....."],  # ¶
+    0x00B7: [".....", ".....", ".....", "..#..", ".....", ".....", ".....", "....."],  # ·
+    0x00B8: [".....", ".....", ".....", ".....", ".....", ".....", "..#..", ".##.."],  # ¸
+    0x00B9: ["..#..", ".##..", "..#..", ".###.", ".....", ".....", ".....", "....."],  # ¹
+    0x00BA: [".##..", "#..#.", ".##..", ".....", "####.", ".....", ".....", "....."],  # º
+    0x00BB: [".....", "#.#..", ".#.#.", "..#.#", ".#.#.", "#.#..", ".....", "....."],  # »
+    0x00BC: ["#...#", "#..#.", "#.#..", ".#.#.", "#.##.", "..###", "...#.", "....."],  # ¼
+    0x00BD: ["#...#", "#..#.", "#.#..", ".#.##", "#...#", "...#.", "..###", "....."],  # ½
+    0x00BE: ["##..#", ".##..", "##.#.", ".#.#.", "#.##.", "..###", "...#.", "....."],  # ¾
+    0x00BF: ["..#..", ".....", "..#..", ".#...", "#....", "#...#", ".###.", "....."],  # ¿
+    0x00C6: [".####", "#.#..", "#.#..", "#####", "#.#..", "#.#..", "#.###", "....."],  # Æ
+    0x00D0: ["####.", ".#..#", ".#..#", "###.#", ".#..#", ".#..#", "####.", "....."],  # Ð
+    0x00D7: [".....", "#...#", ".#.#.", "..#..", ".#.#.", "#...#", ".....", "....."],  # ×
+    0x00D8: [".###.", "#..##", "#.#.#", "#.#.#", "#.#.#", "##..#", ".###.", "....."],  # Ø
+    0x00DE: ["#....", "####.", "#...#", "#...#", "####.", "#....", "#....", "....."],  # Þ
+    0x00DF: [".##..", "#..#.", "#.#..", "#..#.", "#...#", "#...#", "#.##.", "....."],  # ß
+    0x00E6: [".....", ".....", "##.#.", "..#.#", ".####", "#.#..", ".#.##", "....."],  # æ
+    0x00F0: [".#.#.", "..#..", ".#.#.", "....#", ".####", "#...#", ".###.", "....."],  # ð
+    0x00F7: [".....", "..#..", ".....", "#####", ".....", "..#..", ".....", "....."],  # ÷
+    0x00F8: [".....", ".....", ".###.", "#..##", "#.#.#", "##..#", ".###.", "....."],  # ø
+    0x00FE: ["#....", "#....", "####.", "#...#", "#...#", "####.", "#....", "#...."],  # þ
+    0x0402: ["####.", ".#...", ".###.", ".#..#", ".#..#", ".#..#", ".#.#.", "....."],  # Ђ
+    0x0404: [".###.", "#...#", "#....", "####.", "#....", "#...#", ".###.", "....."],  # Є
+    0x0409: [".###..", ".#.#..", ".#.#..", ".#.##.", ".#.#.#", ".#.#.#", "#..##.", "......"],  # Љ
+    0x040A: ["#..#..", "#..#..", "#..#..", "#####.", "#..#.#", "#..#.#", "#..##.", "......"],  # Њ
+    0x040B: ["####.", ".#...", ".###.", ".#..#", ".#..#", ".#..#", ".#..#", "....."],  # Ћ
+    0x040F: ["#...#", "#...#", "#...#", "#...#", "#...#", "#...#", "#####", "..#.."],  # Џ
+    0x0452: [".#...", "###..", ".#...", ".###.", ".#..#", ".#..#", ".#..#", "...#."],  # ђ
+    0x0454: [".....", ".....", ".###.", "#....", "####.", "#....", ".###.", "....."],  # є
+    0x0459: ["......", "......", ".###..", ".#.#..", ".#.##.", ".#.#.#", "#..##.", "......"],  # љ
+    0x045A: ["......", "......", "#..#..", "#..#..", "#####.", "#..#.#", "#..##.", "......"],  # њ
+    0x045B: [".#...", "###..", ".#...", ".###.", ".#..#", ".#..#", ".#..#", "....."],  # ћ
+    0x045F: [".....", ".....", "#...#", "#...#", "#...#", "#...#", "#####", "..#.."],  # џ
+    0x0490: ["....#", "#####", "#....", "#....", "#....", "#....", "#....", "....."],  # Ґ
+    0x0491: [".....", "...#.", "####.", "#....", "#....", "#....", "#....", "....."],  # ґ
+}
+
+# Letters that are accent + base: (accent, base). A one character string
+# base is an ASCII letter or a short capital, anything else a codepoint.
+COMPOSED = {
+    0x00C0: ("grave", "A"), 0x00C1: ("acute", "A"), 0x00C2: ("circ", "A"), 0x00C3: ("tilde", "A"),
+    0x00C4: ("diaer", "A"), 0x00C5: ("ring", "A"),
+    0x00C8: ("grave", "E"), 0x00C9: ("acute", "E"), 0x00CA: ("circ", "E"), 0x00CB: ("diaer", "E"),
+    0x00CC: ("grave", "I"), 0x00CD: ("acute", "I"), 0x00CE: ("circ", "I"), 0x00CF: ("diaer", "I"),
+    0x00D1: ("tilde", "N"),
+    0x00D2: ("grave", "O"), 0x00D3: ("acute", "O"), 0x00D4: ("circ", "O"), 0x00D5: ("tilde", "O"),
+    0x00D6: ("diaer", "O"),
+    0x00D9: ("grave", "U"), 0x00DA: ("acute", "U"), 0x00DB: ("circ", "U"), 0x00DC: ("diaer", "U"),
+    0x00DD: ("acute", "Y"),
+    0x00E0: ("grave", "a"), 0x00E1: ("acute", "a"), 0x00E2: ("circ", "a"), 0x00E3: ("tilde", "a"),
+    0x00E4: ("diaer", "a"), 0x00E5: ("ring", "a"),
+    0x00E8: ("grave", "e"), 0x00E9: ("acute", "e"), 0x00EA: ("circ", "e"), 0x00EB: ("diaer", "e"),
+    0x00EC: ("grave", "ı"), 0x00ED: ("acute", "ı"), 0x00EE: ("circ", "ı"), 0x00EF: ("diaer", "ı"),
+    0x00F1: ("tilde", "n"),
+    0x00F2: ("grave", "o"), 0x00F3: ("acute", "o"), 0x00F4: ("circ", "o"), 0x00F5: ("tilde", "o"),
+    0x00F6: ("diaer", "o"),
+    0x00F9: ("grave", "u"), 0x00FA: ("acute", "u"), 0x00FB: ("circ", "u"), 0x00FC: ("diaer", "u"),
+    0x00FD: ("acute", "y"), 0x00FF: ("diaer", "y"),
+    0x0400: ("grave", "E"), 0x0401: ("diaer", "E"), 0x0403: ("acute", "Г"), 0x0407: ("diaer", "I"),
+    0x040C: ("acute", "К"), 0x040D: ("grave", "И"), 0x040E: ("breve", "У"),
+    0x0450: ("grave", 0x0435), 0x0451: ("diaer", 0x0435), 0x0453: ("acute", 0x0433),
+    0x0457: ("diaer", "ı"), 0x045C: ("acute", 0x043A), 0x045D: ("grave", 0x0438),
+    0x045E: ("breve", 0x0443),
+}
+
+# Letters shared with another codepoint
+ALIASES = {
+    0x00A0: 0x20,  # no-break space
+    0x00C7: 0x43,  # Ç, cedilla added below
+    0x00E7: 0x63,  # ç
+    0x0405: 0x53, 0x0406: 0x49, 0x0408: 0x4A,  # Ѕ І Ј
+    0x0455: 0x73, 0x0456: 0x69, 0x0458: 0x6A,  # ѕ і ј
+}
+
+
+# 4x6 cells: 3x5 glyphs plus a descender row, the fourth column is the gap.
+# Rows are separated by spaces, missing rows are blank. Capitals use rows
+# 0-4, lower case rows 1-4 with ascenders in row 0.
+SMALL_ASCII = {
+    " ": "... ... ... ... ...", "!": ".#. .#. .#. ... .#.", '"': "#.# #.# ... ... ...",
+    "#": "#.# ### #.# ### #.#", "$": ".## ##. .#. .## ##.", "%": "#.# ..# .#. #.. #.#",
+    "&": "##. ##. .## #.# .##", "'": ".#. .#. ... ... ...", "(": "..# .#. .#. .#. ..#",
+    ")": "#.. .#. .#. .#. #..", "*": "... #.# .#. #.# ...", "+": "... .#. ### .#. ...",
+    ",": "... ... ... ... .#. #..", "-": "... ... ### ... ...", ".": "... ... ... ... .#.",
+    "/": "..# ..# .#. #.. #..", "0": "### #.# #.# #.# ###", "1": ".#. ##. .#. .#. ###",
+    "2": "##. ..# .#. #.. ###", "3": "##. ..# .#. ..# ##.", "4": "#.# #.# ### ..# ..#",
+    "5": "### #.. ##. ..# ##.", "6": ".## #.. ### #.# ###", "7": "### ..# .#. .#. .#.",
+    "8": "### #.# ### #.# ###", "9": "### #.# ### ..# ##.", ":": "... .#. ... .#. ...",
+    ";": "... .#. ... .#. #..", "<": "..# .#. #.. .#. ..#", "=": "... ### ... ### ...",
+    ">": "#.. .#. ..# .#. #..", "?": "##. ..# .#. ... .#.", "@": ".#. #.# ### #.. .##",
+    "A": ".#. #.# ### #.# #.#", "B": "##. #.# ##. #.# ##.", "C": ".## #.. #.. #.. .##",
+    "D": "##. #.# #.# #.# ##.", "E": "### #.. ### #.. ###", "F": "### #.. ### #.. #..",
+    "G": ".## #.. #.# #.# .##", "H": "#.# #.# ### #.# #.#", "I": "### .#. .#. .#. ###",
+    "J": "..# ..# ..# #.# .#.", "K": "#.# #.# ##. #.# #.#", "L": "#.. #.. #.. #.. ###",
+    "M": "#.# ### ### #.# #.#", "N": "#.# ### ### ### #.#", "O": ".#. #.# #.# #.# .#.",
+    "P": "##. #.# ##. #.. #..", "Q": ".#. #.# #.# ### .##", "R": "##. #.# ##. #.# #.#",
+    "S": ".## #.. .#. ..# ##.", "T": "### .#. .#. .#. .#.", "U": "#.# #.# #.# #.# ###",
+    "V": "#.# #.# #.# .#. .#.", "W": "#.# #.# ### ### #.#", "X": "#.# #.# .#. #.# #.#",
+    "Y": "#.# #.# .#. .#. .#.", "Z": "### ..# .#. #.. ###", "[": "##. #.. #.. #.. ##.",
+    "\\": "#.. #.. .#. ..# ..#", "]": ".## ..# ..# ..# .##", "^": ".#. #.# ... ... ...",
+    "_": "... ... ... ... ###", "`": "#.. .#. ... ... ...", "a": "... ##. .## #.# ###",
+    "b": "#.. ##. #.# #.# ##.", "c": "... .## #.. #.. .##", "d": "..# .## #.# #.# .##",
+    "e": "... .## ### #.. .##", "f": "..# .#. ### .#. .#.", "g": "... .## #.# .## ..# ##.",
+    "h": "#.. ##. #.# #.# #.#", "i": ".#. ... .#. .#. .#.", "j": "..# ... ..# ..# #.# .#.",
+    "k": "#.. #.# ##. ##. #.#", "l": "##. .#. .#. .#. ###", "m": "... ### ### ### #.#",
+    "n": "... ##. #.# #.# #.#", "o": "... .#. #.# #.# .#.", "p": "... ##. #.# #.# ##. #..",
+    "q": "... .## #.# #.# .## ..#", "r": "... .## #.. #.. #..", "s": "... .## ##. .## ##.",
+    "t": ".#. ### .#. .#. .##", "u": "... #.# #.# #.# .##", "v": "... #.# #.# ### .#.",
+    "w": "... #.# ### ### ###", "x": "... #.# .#. .#. #.#", "y": "... #.# #.# .## ..# ##.",
+    "z": "... ### .## ##. ###", "{": ".## .#. ##. .#. .##", "|": ".#. .#. .#. .#. .#.",
+    "}": "##. .#. .## .#. ##.", "~": "... .## ##. ... ...", "\x7f": ".#. #.# #.# ###",
+}
+
+# Russian alphabet А-я (U+0410-U+044F) in 4x6 cells
+SMALL_CYRILLIC = [
+    ".#. #.# ### #.# #.#", "### #.. ##. #.# ##.", "##. #.# ##. #.# ##.", "### #.. #.. #.. #..",  # А Б В Г
+    ".#. #.# #.# #.# ### #.#", "### #.. ### #.. ###", "#.# ### .#. ### #.#", "##. ..# .#. ..# ##.",  # Д Е Ж З
+    "#.# #.# #.# ##. #.#", ".#. #.# #.# ##. #.#", "#.# #.# ##. #.# #.#", ".## #.# #.# #.# #.#",  # И Й К Л
+    "#.# ### ### #.# #.#", "#.# #.# ### #.# #.#", ".#. #.# #.# #.# .#.", "### #.# #.# #.# #.#",  # М Н О П
+    "##. #.# ##. #.. #..", ".## #.. #.. #.. .##", "### .#. .#. .#. .#.", "#.# #.# .## ..# ##.",  # Р С Т У
+    ".#. ### #.# ### .#.", "#.# #.# .#. #.# #.#", "#.# #.# #.# #.# ### ..#", "#.# #.# .## ..# ..#",  # Ф Х Ц Ч
+    "#.# #.# ### ### ###", "#.# #.# ### ### ### ..#", "##. .#. .## .## .##", "#.# #.# ### #.# ###",  # Ш Щ Ъ Ы
+    "#.. #.. ##. #.# ##.", "##. ..# .## ..# ##.", "#.# ### #.# ### #.#", ".## #.# .## #.# #.#",  # Ь Э Ю Я
+    "... ##. .## #.# ###", ".## #.. ##. #.# .#.", "... ##. ##. #.# ##.", "... ### #.. #.. #..",  # а б в г
+    "... .#. #.# #.# ### #.#", "... .## ### #.. .##", "... #.# .#. ### #.#", "... ##. .#. ..# ##.",  # д е ж з
+    "... #.# #.# ##. #.#", ".#. #.# #.# ##. #.#", "... #.# ##. ##. #.#", "... .## #.# #.# #.#",  # и й к л
+    "... #.# ### ### #.#", "... #.# ### #.# #.#", "... .#. #.# #.# .#.", "... ### #.# #.# #.#",  # м н о п
+    "... ##. #.# #.# ##. #..", "... .## #.. #.. .##", "... ### .#. .#. .#.", "... #.# #.# .## ..# ##.",  # р с т у
+    ".#. ### #.# ### .#.", "... #.# .#. .#. #.#", "... #.# #.# #.# ### ..#", "... #.# #.# .## ..#",  # ф х ц ч
+    "... #.# #.# #.# ###", "... #.# #.# #.# ### ..#", "... ##. .#. .## .##", "... #.# #.# ### ###",  # ш щ ъ ы
+    "... #.. ##. #.# ##.", "... ##. .## ..# ##.", "... #.# ### #.# ###", "... .## #.# .## #.#",  # ь э ю я
+]
+
+# One row accents in row 0, above lower case letters and the short capitals
+SMALL_ACCENTS = {
+    "grave": "#..", "acute": "..#", "circ": ".#.", "tilde": "##.",
+    "diaer": "#.#", "ring": "###", "breve": "#.#",
+}
+
+# Capitals squeezed into rows 1-4
+SMALL_SHORT_CAPS = {
+    "A": ".#. #.# ### #.#", "E": "### ##. #.. ###", "I": "### .#. .#. ###",
+    "N": "#.# ### ### #.#", "O": ".#. #.# #.# .#.", "U": "#.# #.# #.# ###",
+    "Y": "#.# #.# .#. .#.", "Г": "### #.. #.. #..", "И": "#.# #.# ##. #.#",
+    "К": "#.# ##. ##. #.#", "У": "#.# .## ..# ##.",
+}
+
+# Hand drawn 4x6 glyphs, the same codepoints as ART
+SMALL_ART = {
+    0x00A1: ".#. ... .#. .#. .#.", 0x00A2: ".#. .## #.. .## .#.", 0x00A3: ".## .#. ### .#. ###",  # ¡ ¢ £
+    0x00A4: "#.# .#. #.# .#. #.#", 0x00A5: "#.# .#. ### .#. .#.", 0x00A6: ".#. .#. ... .#. .#.",  # ¤ ¥ ¦
+    0x00A7: ".## ##. #.# .## ##.", 0x00A8: "#.# ... ... ... ...", 0x00A9: "### ##. ##. ###",  # § ¨ ©
+    0x00AA: ".## #.# .## ... ###", 0x00AB: "... .## ##. .## ...", 0x00AC: "... ... ### ..# ...",  # ª « ¬
+    0x00AD: "... ... ##. ... ...", 0x00AE: "### #.# ##. #.#", 0x00AF: "### ... ... ... ...",  # shy ® ¯
+    0x00B0: ".#. #.# .#. ... ...", 0x00B1: ".#. ### .#. ... ###", 0x00B2: "##. .#. .## ... ...",  # ° ± ²
+    0x00B3: "##. .#. ##. ... ...", 0x00B4: "..# .#. ... ... ...", 0x00B5: "... #.# #.# #.# ### #..",  # ³ ´ µ
+    0x00B6: ".## ### .## .## .##", 0x00B7: "... ... .#. ... ...", 0x00B8: "... ... ... ... .#. ##.",  # ¶ · ¸
+    0x00B9: ".#. ##. .#. ... ...", 0x00BA: ".#. #.# .#. ... ###", 0x00BB: "... ##. .## ##. ...",  # ¹ º »
+    0x00BC: "#.. #.. .#. .## ..#", 0x00BD: "#.. #.. .## ..# .##", 0x00BE: "##. ##. .#. .## ..#",  # ¼ ½ ¾
+    0x00BF: ".#. ... .#. #.. .##", 0x00C6: ".## ##. ### ##. ###", 0x00D0: "##. #.# ### #.# ##.",  # ¿ Æ Ð
+    0x00D7: "... ... #.# .#. #.#", 0x00D8: ".## #.# ### #.# ##.", 0x00DE: "#.. ##. #.# ##. #..",  # × Ø Þ
+    0x00DF: "##. #.# ##. #.# ##. #..", 0x00E6: "... .## ### ##. .##", 0x00F0: ".## ##. .## #.# .#.",  # ß æ ð
+    0x00F7: ".#. ... ### ... .#.", 0x00F8: "... .## #.# #.# ##.", 0x00FE: "#.. ##. #.# #.# ##. #..",  # ÷ ø þ
+    0x0402: "### #.. ##. #.# #.# ..#", 0x0404: ".## #.. ##. #.. .##", 0x0409: ".#. ##. ##. ### ###",  # Ђ Є Љ
+    0x040A: "#.. #.. ### #.# ###", 0x040B: "### #.. ##. #.# #.#", 0x040F: "#.# #.# #.# #.# ### .#.",  # Њ Ћ Џ
+    0x0452: "#.. ### #.. ##. #.# ..#", 0x0454: "... .## ##. #.. .##", 0x0459: "... .#. ##. ### ###",  # ђ є љ
+    0x045A: "... #.. ### #.# ###", 0x045B: "#.. ### #.. ##. #.#", 0x045F: "... #.# #.# #.# ### .#.",  # њ ћ џ
+    0x0490: "..# ### #.. #.. #..", 0x0491: "... ..# ### #.. #..",  # Ґ ґ
+}
+
+
+def hex_columns(text):
+    columns = [int(b, 16) for b in text.split()]
+    return columns + [0] * (6 - len(columns))
+
+
+def art_columns(rows, top=0, width=6):
+    columns = [0] * width
+    for y, row in enumerate(rows):
+        for x, pixel in enumerate(row):
+            if pixel == "#":
+                columns[x] |= 1 << (top + y)
+    return columns
+
+
+def small_columns(text, top=0):
+    return art_columns(text.split(), top, 4)
+
+
+def merge(a, b):
+    return [x | y for x, y in zip(a, b)]
+
+
+# Box drawing. Stroke positions in the cell: a light line runs through the
+# column left of the middle / the row above the middle (column 2 / row 3 in
+# 6x8 cells), heavy lines are two pixels wide, double lines are two light
+# lines around the light position.
+LIGHT, HEAVY, DOUBLE = 1, 2, 3
+WEIGHTS = {"LIGHT": LIGHT, "SINGLE": LIGHT, "HEAVY": HEAVY, "DOUBLE": DOUBLE}
+DIRECTIONS = {"UP": "u", "DOWN": "d", "LEFT": "l", "RIGHT": "r", "VERTICAL": "ud", "HORIZONTAL": "lr"}
+
+
+class Cell:
+    """Cell size and the stroke positions derived from it"""
+
+    def __init__(self, name, width, height):
+        self.name = name
+        self.width = width
+        self.height = height
+
+    def v_lines(self, weight):
+        """Columns of vertical strokes"""
+        c = self.width // 2 - 1
+        return {LIGHT: [c], HEAVY: [c, c + 1], DOUBLE: [c - 1, c + 1]}[weight]
+
+    def h_lines(self, weight):
+        """Rows of horizontal strokes"""
+        c = self.height // 2 - 1
+        return {LIGHT: [c], HEAVY: [c, c + 1], DOUBLE: [c - 1, c + 1]}[weight]
+
+
+def box_arms(name):
+    """Parse 'BOX DRAWINGS ...' into {direction: weight}. The name is a list
+    of groups joined by AND, each group its directions plus a weight before
+    or after them, or none to reuse the weight of the previous group."""
+    arms = {}
+    weight = None
+    for group in " ".join(name.split()[2:]).split(" AND "):
+        words = group.split()
+        weights = [WEIGHTS[w] for w in words if w in WEIGHTS]
+        if weights:
+            weight = weights[0]
+        for word in words:
+            if word in DIRECTIONS:
+                for d in DIRECTIONS[word]:
+                    arms[d] = weight
+            elif word not in WEIGHTS:
+                raise ValueError(name)
+    return arms
+
+
+def box_pixels(arms, cell):
+    pixels = set()
+    up, down, left, right = (arms.get(d, 0) for d in "udlr")
+    right_edge, bottom_edge = cell.width - 1, cell.height - 1
+    double_cols, double_rows = cell.v_lines(DOUBLE), cell.h_lines(DOUBLE)
+    vertical = [c for w in (up, down) if w for c in cell.v_lines(w)] or cell.v_lines(LIGHT)
+    horizontal = [r for w in (left, right) if w for r in cell.h_lines(w)] or cell.h_lines(LIGHT)
+    vmin, vmax = min(vertical), max(vertical)
+    hmin, hmax = min(horizontal), max(horizontal)
+
+    def hline(row, x0, x1):
+        pixels.update((x, row) for x in range(x0, x1 + 1))
+
+    def vline(col, y0, y1):
+        pixels.update((col, y) for y in range(y0, y1 + 1))
+
+    for side, weight in (("l", left), ("r", right)):
+        if not weight:
+            continue
+        if weight != DOUBLE:
+            # Stops at the near line of a double vertical crossing it
+            inner = (up == DOUBLE and down == DOUBLE)
+            for row in cell.h_lines(weight):
+                if side == "l":
+                    hline(row, 0, double_cols[0] if inner else vmax)
+                else:
+                    hline(row, double_cols[1] if inner else vmin, right_edge)
+            continue
+        # Each line of a double arm ends where it meets the perpendicular
+        # arm on its side, or runs to the far edge of the vertical strokes
+        for row, crossing in zip(double_rows, (up, down)):
+            if side == "l":
+                hline(row, 0, min(cell.v_lines(crossing)) if crossing else vmax)
+            else:
+                hline(row, max(cell.v_lines(crossing)) if crossing else vmin, right_edge)
+
+    for side, weight in (("u", up), ("d", down)):
+        if not weight:
+            continue
+        if weight != DOUBLE:
+            inner = (left == DOUBLE and right == DOUBLE)
+            for col in cell.v_lines(weight):
+                if side == "u":
+                    vline(col, 0, double_rows[0] if inner else hmax)
+                else:
+                    vline(col, double_rows[1] if inner else hmin, bottom_edge)
+            continue
+        for col, crossing in zip(double_cols, (left, right)):
+            if side == "u":
+                vline(col, 0, min(cell.h_lines(crossing)) if crossing else hmax)
+            else:
+                vline(col, max(cell.h_lines(crossing)) if crossing else hmin, bottom_edge)
+    return pixels
+
+
+def dash_gaps(size, count):
+    """Last pixel of each of count dashes over size pixels, left blank"""
+    count = min(count, size // 2)
+    return {-(-size * k // count) - 1 for k in range(1, count + 1)}
+
+
+def box_pixels_of(codepoint, cell):
+    name = unicodedata.name(chr(codepoint))
+    w, h = cell.width, cell.height
+    pixels = set()
+    if "DASH" in name:
+        weight = HEAVY if "HEAVY" in name else LIGHT
+        count = {"DOUBLE": 2, "TRIPLE": 3, "QUADRUPLE": 4}[name.split()[3]]
+        if name.endswith("HORIZONTAL"):
+            gaps = dash_gaps(w, count)
+            pixels = {(x, y) for y in cell.h_lines(weight) for x in range(w) if x not in gaps}
+        else:
+            gaps = dash_gaps(h, count)
+            pixels = {(x, y) for x in cell.v_lines(weight) for y in range(h) if y not in gaps}
+    elif "ARC" in name:
+        # Corner without its joint pixel
+        arms = box_arms(name.replace(" ARC", ""))
+        pixels = box_pixels(arms, cell) - {(cell.v_lines(LIGHT)[0], cell.h_lines(LIGHT)[0])}
+    elif "DIAGONAL" in name:
+        if "UPPER RIGHT" in name or "CROSS" in name:
+            pixels |= {(w - 1 - (y * w) // h, y) for y in range(h)}
+        if "UPPER LEFT" in name or "CROSS" in name:
+            pixels |= {((y * w) // h, y) for y in range(h)}
+    else:
+        pixels = box_pixels(box_arms(name), cell)
+    return pixels
+
+
+# Block elements: eighths of the cell rounded to whole pixels, quadrants
+# split at the middle of the cell
+def block_rect(x0, y0, x1, y1):
+    return {(x, y) for x in range(x0, x1) for y in range(y0, y1)}
+
+
+# Shade levels: pixels set in a 2x2 pattern, so shaded areas tile across cells
+SHADES = {0x2591: 1, 0x2592: 2, 0x2593: 3}
+
+
+def shade_pixel(level, x, y):
+    if level == 1:
+        return x % 2 == 0 and y % 2 == 0
+    if level == 2:
+        return (x + y) % 2 == 0
+    return not (x % 2 == 1 and y % 2 == 1)
+
+
+def block_pixels_of(codepoint, cell):
+    w, h = cell.width, cell.height
+    eighth = lambda n, size: (size * n + 4) // 8
+    if 0x2581 <= codepoint <= 0x2588:  # lower n eighths
+        return block_rect(0, h - eighth(codepoint - 0x2580, h), w, h)
+    if 0x2589 <= codepoint <= 0x258F:  # left n eighths
+        return block_rect(0, 0, eighth(0x2590 - codepoint, w), h)
+    quadrants = {"ul": block_rect(0, 0, w // 2, h // 2), "ur": block_rect(w // 2, 0, w, h // 2),
+                 "ll": block_rect(0, h // 2, w // 2, h), "lr": block_rect(w // 2, h // 2, w, h)}
+    corners = {
+        0x2596: "ll", 0x2597: "lr", 0x2598: "ul", 0x2599: "ul ll lr", 0x259A: "ul lr",
+        0x259B: "ul ur ll", 0x259C: "ul ur lr", 0x259D: "ur", 0x259E: "ur ll", 0x259F: "ur ll lr",
+    }
+    if codepoint in corners:
+        return set().union(*(quadrants[q] for q in corners[codepoint].split()))
+    return {
+        0x2580: block_rect(0, 0, w, h // 2),            # upper half
+        0x2590: block_rect(w // 2, 0, w, h),            # right half
+        0x2594: block_rect(0, 0, w, eighth(1, h)),      # upper eighth
+        0x2595: block_rect(w - eighth(1, w), 0, w, h),  # right eighth
+    }[codepoint]
+
+
+def shape_rects(pixels):
+    """Cover a pixel set with few rectangles (x, y, w, h), overlaps allowed"""
+    rects = []
+    todo = set(pixels)
+    while todo:
+        x0, y0 = min(todo, key=lambda p: (p[1], p[0]))
+        best = None
+        for wide_first in (True, False):
+            w, h = 1, 1
+            grow = [(1, 0), (0, 1)] if wide_first else [(0, 1), (1, 0)]
+            for dx, dy in grow:
+                while all((x0 + x, y0 + y) in pixels
+                          for x in range(w + dx) for y in range(h + dy)):
+                    w, h = w + dx, h + dy
+            covered = {(x0 + x, y0 + y) for x in range(w) for y in range(h)}
+            if best is None or len(covered & todo) > len(best[1] & todo):
+                best = ((x0, y0, w, h), covered)
+        rects.append(best[0])
+        todo -= best[1]
+    return rects
+
+
+def build_shapes(cell):
+    """Rectangles (x, y, w, h, shade) of every shape codepoint"""
+    shapes = {}
+    for code in range(SHAPES[0], SHAPES[1] + 1):
+        if code in SHADES:
+            shapes[code] = [(0, 0, cell.width, cell.height, SHADES[code])]
+        elif code < 0x2580:
+            shapes[code] = [r + (0,) for r in shape_rects(box_pixels_of(code, cell))]
+        else:
+            shapes[code] = [r + (0,) for r in shape_rects(block_pixels_of(code, cell))]
+    return shapes
+
+
+def shape_columns(rects, cell):
+    columns = [0] * cell.width
+    for x0, y0, w, h, shade in rects:
+        for x in range(x0, x0 + w):
+            for y in range(y0, y0 + h):
+                if not shade or shade_pixel(shade, x, y):
+                    columns[x] |= 1 << y
+    return columns
+
+
+def build_glyphs(shapes, cell):
+    glyphs = {code: shape_columns(rects, cell) for code, rects in shapes.items()}
+    for code, text in ASCII.items():
+        glyphs[code] = hex_columns(text)
+    for code in range(0x20):
+        glyphs[code] = [0] * 6
+    for i, text in enumerate(CYRILLIC):
+        glyphs[0x0410 + i] = hex_columns(text)
+    for code, rows in ART.items():
+        glyphs[code] = art_columns(rows)
+    for code, target in ALIASES.items():
+        glyphs[code] = list(glyphs[target])
+    # Cedilla under Ç and ç
+    for code in (0x00C7, 0x00E7):
+        glyphs[code] = merge(glyphs[code], art_columns([".##.."], 7))
+    dotless_i = art_columns([".##..", "..#..", "..#..", "..#..", ".###."], 2)
+    for code, (accent, base) in COMPOSED.items():
+        if base == "ı":
+            body = dotless_i
+        elif isinstance(base, str) and base in SHORT_CAPS:
+            body = art_columns(SHORT_CAPS[base], 2)
+        elif isinstance(base, str):
+            body = glyphs[ord(base)]
+        else:
+            body = glyphs[base]
+        glyphs[code] = merge(body, art_columns(ACCENTS[accent]))
+    return glyphs
+
+
+def build_small_glyphs(shapes, cell):
+    """Same letters as build_glyphs() for 4x6 cells"""
+    glyphs = {code: shape_columns(rects, cell) for code, rects in shapes.items()}
+    for char, text in SMALL_ASCII.items():
+        glyphs[ord(char)] = small_columns(text)
+    for code in range(0x20):
+        glyphs[code] = [0] * 4
+    for i, text in enumerate(SMALL_CYRILLIC):
+        glyphs[0x0410 + i] = small_columns(text)
+    for code, text in SMALL_ART.items():
+        glyphs[code] = small_columns(text)
+    for code, target in ALIASES.items():
+        glyphs[code] = list(glyphs[target])
+    for code in (0x00C7, 0x00E7):
+        glyphs[code] = merge(glyphs[code], small_columns(".#.", 5))
+    dotless_i = small_columns(".#. .#. .#.", 2)
+    for code, (accent, base) in COMPOSED.items():
+        if base == "ı":
+            body = dotless_i
+        elif isinstance(base, str) and base in SMALL_SHORT_CAPS:
+            body = small_columns(SMALL_SHORT_CAPS[base], 1)
+        elif isinstance(base, str):
+            body = glyphs[ord(base)]
+        else:
+            body = glyphs[base]
+        glyphs[code] = merge(body, small_columns(SMALL_ACCENTS[accent]))
+    return glyphs
+
+
+def build_ranges():
+    ranges = []
+    index = 0
+    for first, last in RANGES:
+        ranges.append((first, last - first + 1, index))
+        index += last - first + 1
+    assert all(a[0] + a[1] <= b[0] for a, b in zip(ranges, ranges[1:])), "ranges must be sorted"
+    assert len(ranges) <= RANGE_TABLE_SIZE
+    assert index <= 0x1000, "font index must fit CELL_GLYPH_MASK"
+    return ranges, index
+
+
+def preview(glyphs, codes, cell):
+    for code in codes:
+        columns = glyphs[code]
+        print("U+%04X %s" % (code, chr(code) if code >= 0x20 else ""))
+        for y in range(cell.height):
+            print("  " + "".join("#" if columns[x] & (1 << y) else "." for x in range(cell.width)))
+
+
+def shape_pattern(shade):
+    """2x2 fill pattern of a shade level, bit (y & 1) * 2 + (x & 1)"""
+    return sum(1 << (y * 2 + x) for y in range(2) for x in range(2)
+               if not shade or shade_pixel(shade, x, y))
+
+
+def write_header(name, lines):
+    path = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", name)
+    with open(path, "w", encoding="utf-8") as f:
+        f.write("\n".join(lines).replace(" \n", "\n"))
+
+
+def glyph_label(code):
+    if code == 0x5C:
+        return "backslash"
+    if code >= 0x20 and code != 0x7F and unicodedata.category(chr(code))[0] not in "CZ":
+        return chr(code)
+    return ""
+
+
+def shapes_header(cells, shapes, ranges):
+    first_index = [index + SHAPES[0] - first for first, size, index in ranges
+                   if first <= SHAPES[0] and SHAPES[1] < first + size]
+    assert first_index, "shape codepoints must be one atlas range"
+    out = []
+    out.append("/*")
+    out.append(" * glyphshapes.h - Box drawing and block element shapes")
+    out.append(" *")
+    out.append(" * Generated by tools/glyphgen.py, do not edit.")
+    out.append(" * Included by renderer.cpp only.")
+    out.append(" */")
+    out.append("")
+    out.append("#ifndef GLYPHSHAPES_H")
+    out.append("#define GLYPHSHAPES_H")
+    out.append("")
+    out.append("#include <Arduino.h>")
+    out.append("")
+    out.append("// Font indices of U+%04X-U+%04X" % SHAPES)
+    out.append("#define GLYPH_SHAPE_FIRST %d" % first_index[0])
+    out.append("#define GLYPH_SHAPE_COUNT %d" % (SHAPES[1] - SHAPES[0] + 1))
+    out.append("")
+    out.append("// Filled rectangle in cell pixels. pattern is a 2x2 mask, bit")
+    out.append("// (y & 1) * 2 + (x & 1), 0xF for solid and less for shades")
+    out.append("struct GlyphRect {")
+    out.append("  uint8_t x;")
+    out.append("  uint8_t y;")
+    out.append("  uint8_t w;")
+    out.append("  uint8_t h;")
+    out.append("  uint8_t pattern;")
+    out.append("};")
+    for cell in cells:
+        start = [0]
+        rects = []
+        for code in range(SHAPES[0], SHAPES[1] + 1):
+            for i, (x, y, w, h, shade) in enumerate(shapes[cell.name][code]):
+                label = "  // U+%04X %s" % (code, chr(code)) if i == 0 else ""
+                rects.append("  {%d, %d, %d, %d, 0x%X},%s" % (x, y, w, h, shape_pattern(shade), label))
+            start.append(len(rects))
+        out.append("")
+        out.append("// %s cells. Rectangles of shape n: glyphShapeRects%s[glyphShapeStart%s[n]]" %
+                   (cell.name, cell.name, cell.name))
+        out.append("// up to glyphShapeRects%s[glyphShapeStart%s[n + 1]]" % (cell.name, cell.name))
+        out.append("static const uint16_t glyphShapeStart%s[GLYPH_SHAPE_COUNT + 1] = {" % cell.name)
+        for i in range(0, len(start), 16):
+            out.append("  " + ", ".join(str(v) for v in start[i:i + 16]) + ",")
+        out.append("};")
+        out.append("")
+        out.append("static const GlyphRect glyphShapeRects%s[%d] = {" % (cell.name, len(rects)))
+        out.extend(rects)
+        out.append("};")
+    out.append("")
+    out.append("// Shapes of each cell font, in glyphFonts order")
+    out.append("struct GlyphShapeFont {")
+    out.append("  const uint16_t* start;")
+    out.append("  const GlyphRect* rects;")
+    out.append("};")
+    out.append("")
+    out.append("static const GlyphShapeFont glyphShapeFonts[%d] = {" % len(cells))
+    for cell in cells:
+        out.append("  {glyphShapeStart%s, glyphShapeRects%s}," % (cell.name, cell.name))
+    out.append("};")
+    out.append("")
+    out.append("#endif")
+    out.append("")
+    return out
+
+
+def atlas_header(cells, glyphs, ranges, count, codes):
+    out = []
+    out.append("/*")
+    out.append(" * glyphatlas.h - Terminal glyph atlas")
+    out.append(" *")
+    out.append(" * Generated by tools/glyphgen.py, do not edit.")
+    out.append(" * Included by utf8.cpp only.")
+    out.append(" */")
+    out.append("")
+    out.append("#ifndef GLYPHATLAS_H")
+    out.append("#define GLYPHATLAS_H")
+    out.append("")
+    out.append("#include <Arduino.h>")
+    out.append("")
+    out.append("#define GLYPH_ATLAS_COUNT %d" % count)
+    out.append("#define GLYPH_RANGE_COUNT %d" % RANGE_TABLE_SIZE)
+    out.append("#define GLYPH_FONT_COUNT %d" % len(cells))
+    out.append("")
+    out.append("// Codepoints first..first+count-1 have font indices index..index+count-1")
+    out.append("struct GlyphRange {")
+    out.append("  uint32_t first;")
+    out.append("  uint16_t count;")
+    out.append("  uint16_t index;")
+    out.append("};")
+    out.append("")
+    out.append("// Sorted by codepoint (and font index), padded with entries no")
+    out.append("// codepoint or index reaches")
+    out.append("static const GlyphRange glyphRanges[GLYPH_RANGE_COUNT] = {")
+    for first, size, index in ranges:
+        out.append("  {0x%04X, %d, %d}," % (first, size, index))
+    for _ in range(RANGE_TABLE_SIZE - len(ranges)):
+        out.append("  {0xFFFFFFFF, 0, 0xFFFF},")
+    out.append("};")
+    for cell in cells:
+        out.append("")
+        out.append("// %s cells: %d column bytes per font index, LSB at top" % (cell.name, cell.width))
+        out.append("static const uint8_t glyphAtlas%s[GLYPH_ATLAS_COUNT][%d] PROGMEM = {" %
+                   (cell.name, cell.width))
+        for code in codes:
+            columns = ", ".join("0x%02X" % c for c in glyphs[cell.name][code])
+            out.append("  {%s},  // U+%04X %s" % (columns, code, glyph_label(code)))
+        out.append("};")
+    out.append("")
+    out.append("// Cell fonts, in the order of FONTS in tools/glyphgen.py")
+    out.append("struct GlyphFont {")
+    out.append("  uint8_t width;           // Cell size in pixels")
+    out.append("  uint8_t height;")
+    out.append("  const uint8_t* columns;  // width column bytes per font index")
+    out.append("};")
+    out.append("")
+    out.append("static const GlyphFont glyphFonts[GLYPH_FONT_COUNT] = {")
+    for cell in cells:
+        out.append("  {%d, %d, &glyphAtlas%s[0][0]}," % (cell.width, cell.height, cell.name))
+    out.append("};")
+    out.append("")
+    out.append("#endif")
+    out.append("")
+    return out
+
+
+def main():
+    cells = [Cell(*font) for font in FONTS]
+    shapes = {cell.name: build_shapes(cell) for cell in cells}
+    builders = {"6x8": build_glyphs, "4x6": build_small_glyphs}
+    glyphs = {cell.name: builders[cell.name](shapes[cell.name], cell) for cell in cells}
+    ranges, count = build_ranges()
+    codes = [code for first, last in RANGES for code in range(first, last + 1)]
+    for cell in cells:
+        missing = [code for code in codes if code not in glyphs[cell.name]]
+        assert not missing, "no %s glyph for %s" % (cell.name, ", ".join("U+%04X" % c for c in missing))
+        assert all(len(glyphs[cell.name][code]) == cell.width for code in codes)
+
+    if "--preview" in sys.argv:
+        args = sys.argv[sys.argv.index("--preview") + 1:]
+        cell = next((c for c in cells if args and c.name == args[0]), cells[0])
+        preview(glyphs[cell.name], codes, cell)
+        return
+
+    write_header("glyphatlas.h", atlas_header(cells, glyphs, ranges, count, codes))
+    write_header("glyphshapes.h", shapes_header(cells, shapes, ranges))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,350 @@
+/*
+ * uartio.cpp - UART I/O implementation
+ *
+ * A pinned RX task moves bytes from HardwareSerial into a single-producer /
+ * single-consumer ring buffer. The main loop (parser and renderer) consumes
+ * from the ring on the other core, so slow display or SD work never stalls
+ * reception.
+ *
+ * With UART_IDF_DRIVER enabled the RX task sits on the ESP-IDF uart driver
+ * event queue instead of polling available(): the hardware RX-timeout and
+ * FIFO-full interrupts wake it only when data is there.
+ *
+ * The RX task is never deleted from outside: reopening the port asks it to
+ * leave its loop and waits until it has deleted itself, so it can't die
+ * holding the port or waiting on a driver queue that is about to be freed.
+ */
+
+#include "uartio.h"
+#include <atomic>
+#include "freertos/semphr.h"
+
+#if UART_IDF_DRIVER
+#include "driver/uart.h"
+#include "esp_idf_version.h"
+#include "freertos/queue.h"
+#endif
+
+#if (RX_RING_SIZE & (RX_RING_SIZE - 1)) != 0
+#error "RX_RING_SIZE must be a power of two"
+#endif
+
+// UART state
+static bool uartOpen = false;
+static TaskHandle_t rxTaskHandle = nullptr;
+static TaskHandle_t consumerTaskHandle = nullptr;
+
+// RX task shutdown: set before the task is woken, the task gives
+// rxTaskDone when it has left its loop
+static volatile bool rxStopping = false;
+static SemaphoreHandle_t rxTaskDone = nullptr;
+
+#if UART_IDF_DRIVER
+static uart_port_t uartPort = UART_NUM_0;
+static QueueHandle_t uartEventQueue = nullptr;
+#else
+static HardwareSerial* uartSerial = nullptr;
+static SemaphoreHandle_t rxWake = nullptr;  // Given by the port's receive callback
+#endif
+
+// Ring buffer - head is written only by the RX task, tail only by the consumer.
+// Indices run freely and are masked on access.
+static uint8_t rxRing[RX_RING_SIZE];
+static std::atomic<uint32_t> rxHead(0);
+static std::atomic<uint32_t> rxTail(0);
+
+// Statistics (written by the RX task only)
+static volatile uint32_t statTotalBytes = 0;
+static volatile uint32_t statHighWater = 0;
+static volatile uint32_t statOverflows = 0;
+static volatile uint32_t statDroppedBytes = 0;
+static volatile uint32_t statDriverOverflows = 0;
+
+// Producer side: copy data into the ring, returns number of bytes stored
+static size_t ringPush(const uint8_t* data, size_t len) {
+  uint32_t head = rxHead.load(std::memory_order_relaxed);
+  uint32_t tail = rxTail.load(std::memory_order_acquire);
+  uint32_t space = RX_RING_SIZE - (head - tail);
+  if (len > space) len = space;
+  
+  // Copy in up to two parts (wrap around the end of the buffer)
+  uint32_t start = head & (RX_RING_SIZE - 1);
+  size_t first = RX_RING_SIZE - start;
+  if (first > len) first = len;
+  memcpy(&rxRing[start], data, first);
+  memcpy(&rxRing[0], data + first, len - first);
+  
+  rxHead.store(head + len, std::memory_order_release);
+  
+  uint32_t fill = (head + len) - tail;
+  if (fill > statHighWater) statHighWater = fill;
+  
+  return len;
+}
+
+// Store a received chunk and wake the consumer
+static void rxDeliver(const uint8_t* data, size_t len) {
+  statTotalBytes += len;
+  size_t stored = ringPush(data, len);
+  if (stored < len) {
+    // Consumer fell behind - drop the rest and count it
+    statOverflows++;
+    statDroppedBytes += len - stored;
+  }
+  
+  if (consumerTaskHandle != nullptr) {
+    xTaskNotifyGive(consumerTaskHandle);
+  }
+}
+
+#if UART_IDF_DRIVER
+
+// Event type that only wakes the RX task to stop, never sent by the driver
+#define RX_EVENT_STOP UART_EVENT_MAX
+
+static void rxTask(void* param) {
+  uint8_t chunk[RX_CHUNK_SIZE];
+  uart_event_t event;
+  
+  while (!rxStopping) {
+    // Block until the driver reports something
+    if (xQueueReceive(uartEventQueue, &event, portMAX_DELAY) != pdTRUE) {
+      continue;
+    }
+    
+    switch (event.type) {
+      case UART_DATA: {
+        // Drain what the driver has buffered, not only this event's bytes
+        size_t pending = 0;
+        uart_get_buffered_data_len(uartPort, &pending);
+        while (pending > 0) {
+          size_t want = pending > sizeof(chunk) ? sizeof(chunk) : pending;
+          int got = uart_read_bytes(uartPort, chunk, want, 0);
+          if (got <= 0) break;
+          rxDeliver(chunk, got);
+          pending -= got;
+        }
+        break;
+      }
+      
+      case UART_FIFO_OVF:
+      case UART_BUFFER_FULL:
+        // Driver lost data - start over with a clean buffer
+        statDriverOverflows++;
+        uart_flush_input(uartPort);
+        xQueueReset(uartEventQueue);
+        break;
+        
+      default:
+        break;
+    }
+  }
+  
+  xSemaphoreGive(rxTaskDone);
+  vTaskDelete(nullptr);
+}
+
+// Wake the RX task so it sees rxStopping. Sent to the front of the queue,
+// so no data event is read after the stop.
+static void rxTaskWake() {
+  uart_event_t event = {};
+  event.type = RX_EVENT_STOP;
+  xQueueSendToFront(uartEventQueue, &event, portMAX_DELAY);
+}
+
+static void uartOpenPort(int baudRate, int mode) {
+  // Release the Arduino driver on this port first
+  if (mode == 0) {
+    Serial.end();
+    uartPort = UART_NUM_0;
+  } else {
+    Serial2.end();
+    uartPort = UART_NUM_2;
+  }
+  
+  uart_config_t config = {};
+  config.baud_rate = baudRate;
+  config.data_bits = UART_DATA_8_BITS;
+  config.parity = UART_PARITY_DISABLE;
+  config.stop_bits = UART_STOP_BITS_1;
+  config.flow_ctrl = UART_HW_FLOWCTRL_DISABLE;
+#if ESP_IDF_VERSION_MAJOR >= 5
+  config.source_clk = UART_SCLK_DEFAULT;
+#else
+  config.source_clk = UART_SCLK_APB;  // IDF 4.4 (Arduino-ESP32 2.x)
+#endif
+  
+  uart_param_config(uartPort, &config);
+  uart_set_pin(uartPort, UART_TX, UART_RX, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE);
+  uart_driver_install(uartPort, UART_RX_BUFFER_SIZE, 0, UART_EVENT_QUEUE_LEN, &uartEventQueue, 0);
+  
+  // Interrupt when the FIFO fills up or the line goes idle for a few symbols
+  uart_set_rx_full_threshold(uartPort, UART_RX_FIFO_FULL_THRESHOLD);
+  uart_set_rx_timeout(uartPort, UART_RX_TIMEOUT_SYMBOLS);
+}
+
+#else
+
+// Runs in the HardwareSerial event task when the FIFO fills or the line
+// goes idle. The semaphore outlives every RX task, so a late call is harmless.
+static void rxReceived() {
+  xSemaphoreGive(rxWake);
+}
+
+static void rxTask(void* param) {
+  uint8_t chunk[RX_CHUNK_SIZE];
+  HardwareSerial* serial = uartSerial;
+  
+  while (!rxStopping) {
+    int available = serial->available();
+    if (available <= 0) {
+      // Nothing pending - block until the port or uartIoBegin() wakes us
+      xSemaphoreTake(rxWake, portMAX_DELAY);
+      continue;
+    }
+    
+    if (available > (int)sizeof(chunk)) available = sizeof(chunk);
+    int got = serial->read(chunk, available);
+    if (got <= 0) continue;
+    
+    rxDeliver(chunk, got);
+  }
+  
+  xSemaphoreGive(rxTaskDone);
+  vTaskDelete(nullptr);
+}
+
+// Wake the RX task so it sees rxStopping
+static void rxTaskWake() {
+  xSemaphoreGive(rxWake);
+}
+
+static void uartOpenPort(int baudRate, int mode) {
+  // RX buffer must be resized before begin(), so restart the port
+  if (mode == 0) {
+    // USB UART (Serial)
+    Serial.end();
+    Serial.setRxBufferSize(UART_RX_BUFFER_SIZE);
+    Serial.begin(baudRate);
+    Serial.onReceive(rxReceived, false);
+    uartSerial = &Serial;
+  } else {
+    // External UART on GPIO3/1
+    Serial2.end();
+    Serial2.setRxBufferSize(UART_RX_BUFFER_SIZE);
+    Serial2.begin(baudRate, SERIAL_8N1, UART_RX, UART_TX);
+    Serial2.onReceive(rxReceived, false);
+    uartSerial = &Serial2;
+  }
+}
+
+#endif
+
+// Ask the RX task to stop and wait until it has deleted itself
+static void rxTaskStop() {
+  if (rxTaskHandle == nullptr) return;
+  
+  rxStopping = true;
+  rxTaskWake();
+  xSemaphoreTake(rxTaskDone, portMAX_DELAY);
+  rxTaskHandle = nullptr;
+  rxStopping = false;
+}
+
+void uartIoBegin(int baudRate, int mode) {
+  if (rxTaskDone == nullptr) {
+    rxTaskDone = xSemaphoreCreateBinary();
+#if !UART_IDF_DRIVER
+    rxWake = xSemaphoreCreateBinary();
+#endif
+  }
+  
+  // Stop previous RX task before touching the port (or freeing the driver
+  // queue it waits on)
+  rxTaskStop();
+  
+#if UART_IDF_DRIVER
+  if (uartOpen) {
+    uart_driver_delete(uartPort);
+  }
+#endif
+  
+  uartOpenPort(baudRate, mode);
+  uartOpen = true;
+  
+  rxHead.store(0);
+  rxTail.store(0);
+  uartIoResetStats();
+  
+  // The caller (loop task) is the consumer that gets woken on new data
+  consumerTaskHandle = xTaskGetCurrentTaskHandle();
+  
+  // RX task runs on the other core than loop()
+  xTaskCreatePinnedToCore(rxTask, "uart_rx", RX_TASK_STACK_SIZE, nullptr,
+                          RX_TASK_PRIORITY, &rxTaskHandle, RX_TASK_CORE);
+}
+
+bool uartIoIsOpen() {
+  return uartOpen;
+}
+
+bool uartIoWaitForData(uint32_t timeoutMs) {
+  if (uartIoAvailable() > 0) return true;
+  
+  // Sleep until the RX task signals new data or the timeout expires
+  ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(timeoutMs));
+  return uartIoAvailable() > 0;
+}
+
+size_t uartIoAvailable() {
+  uint32_t head = rxHead.load(std::memory_order_acquire);
+  uint32_t tail = rxTail.load(std::memory_order_relaxed);
+  return head - tail;
+}
+
+size_t uartIoRead(uint8_t* buffer, size_t len) {
+  uint32_t head = rxHead.load(std::memory_order_acquire);
+  uint32_t tail = rxTail.load(std::memory_order_relaxed);
+  size_t available = head - tail;
+  if (len > available) len = available;
+  if (len == 0) return 0;
+  
+  uint32_t start = tail & (RX_RING_SIZE - 1);
+  size_t first = RX_RING_SIZE - start;
+  if (first > len) first = len;
+  memcpy(buffer, &rxRing[start], first);
+  memcpy(buffer + first, &rxRing[0], len - first);
+  
+  rxTail.store(tail + len, std::memory_order_release);
+  return len;
+}
+
+void uartIoWrite(const uint8_t* data, size_t len) {
+  if (!uartOpen) return;
+  
+#if UART_IDF_DRIVER
+  uart_write_bytes(uartPort, data, len);
+#else
+  uartSerial->write(data, len);
+#endif
+}
+
+void uartIoPrint(const char* text) {
+  uartIoWrite((const uint8_t*)text, strlen(text));
+}
+
+void uartIoGetStats(UartRxStats* stats) {
+  stats->totalBytes = statTotalBytes;
+  stats->highWater = statHighWater;
+  stats->overflows = statOverflows;
+  stats->droppedBytes = statDroppedBytes;
+  stats->driverOverflows = statDriverOverflows;
+}
+
+void uartIoResetStats() {
+  statTotalBytes = 0;
+  statHighWater = 0;
+  statOverflows = 0;
+  statDroppedBytes = 0;
+  statDriverOverflows = 0;
+}
@@ -0,0 +1,44 @@
+/*
+ * uartio.h - UART I/O with dedicated RX task and lock-free ring buffer
+ */
+
+#ifndef UARTIO_H
+#define UARTIO_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// RX ring buffer statistics
+struct UartRxStats {
+  uint32_t totalBytes;    // Bytes received from the UART
+  uint32_t highWater;     // Max bytes ever waiting in the ring buffer
+  uint32_t overflows;     // Times the ring buffer was full when data arrived
+  uint32_t droppedBytes;  // Bytes lost because the ring buffer was full
+  uint32_t driverOverflows; // UART FIFO / driver buffer overflows (IDF driver only)
+};
+
+// Open UART (0 = USB, 1 = External) and start the RX task
+void uartIoBegin(int baudRate, int mode);
+
+// Check if UART is open
+bool uartIoIsOpen();
+
+// Consumer side: bytes waiting in the ring buffer
+size_t uartIoAvailable();
+
+// Consumer side: read up to len bytes, returns number of bytes read
+size_t uartIoRead(uint8_t* buffer, size_t len);
+
+// Consumer side: sleep until data arrives or timeout expires,
+// returns true if data is available
+bool uartIoWaitForData(uint32_t timeoutMs);
+
+// Send data to UART
+void uartIoWrite(const uint8_t* data, size_t len);
+void uartIoPrint(const char* text);
+
+// RX statistics
+void uartIoGetStats(UartRxStats* stats);
+void uartIoResetStats();
+
+#endif
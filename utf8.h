@@ -1,5 +1,5 @@
 /*
- * utf8.h - UTF-8 decoder and Cyrillic font support
+ * utf8.h - UTF-8 decoder and glyph lookup
  */
 
 #ifndef UTF8_H
@@ -24,13 +24,47 @@ bool utf8Decode(UTF8Decoder* decoder, uint8_t byte);
 // Get decoded codepoint
 uint32_t utf8GetCodepoint(UTF8Decoder* decoder);
 
+// Encode codepoint as UTF-8 into out (up to 4 bytes), returns byte count
+int utf8Encode(uint32_t codepoint, uint8_t* out);
+
 // Check if character is Cyrillic
 bool isCyrillic(uint32_t codepoint);
 
-// Convert Unicode codepoint to internal font index
+// Font index space: one index per glyph of the atlas, assigned in codepoint
+// order. 0-127 is ASCII, then Latin-1 (U+00A0-U+00FF), Cyrillic
+// (U+0400-U+045F, U+0490-U+0491), box drawing and block elements
+// (U+2500-U+259F).
+
+// Largest scale drawUnicodeChar() supports (keyboard keys use 2)
+#define UNICODE_CHAR_MAX_SCALE 3
+
+// Convert Unicode codepoint to internal font index ('?' if there is no glyph)
 uint16_t unicodeToFontIndex(uint32_t codepoint);
 
-// Draw Unicode character at position
+// Convert internal font index back to Unicode codepoint
+uint32_t fontIndexToUnicode(uint16_t index);
+
+// Lower-case font index for case-insensitive matching (Latin and Cyrillic)
+uint16_t fontIndexFoldCase(uint16_t index);
+
+// Get the 6 column bytes (LSB at top) of a font index, '?' if it has no glyph
+void getGlyphColumns(uint16_t fontIndex, uint8_t* columns);
+
+// Terminal cell fonts. Every font has a bitmap for each font index, so
+// cells don't change when the font is switched.
+#define CELL_FONT_6X8 0  // 53x27 grid
+#define CELL_FONT_4X6 1  // 80x36 grid
+#define CELL_FONT_COUNT 2
+
+// Cell size of a cell font in pixels
+int cellFontWidth(int font);
+int cellFontHeight(int font);
+
+// Get the cellFontWidth(font) column bytes of a font index in a cell font
+void getCellGlyphColumns(int font, uint16_t fontIndex, uint8_t* columns);
+
+// Draw Unicode character at position, scaled up to UNICODE_CHAR_MAX_SCALE.
+// The scaled bitmap is written as one window.
 void drawUnicodeChar(uint32_t codepoint, int x, int y, uint16_t fgColor, uint16_t bgColor, int scale = 2);
 
 #endif
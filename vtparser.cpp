@@ -0,0 +1,283 @@
+/*
+ * vtparser.cpp - Table-driven VT500-class escape sequence parser
+ *
+ * Every byte is first mapped to a character class, then a state x class
+ * table gives the transition action and the next state. Entry and exit
+ * actions (clear, hook/unhook, osc start/end) are attached to states.
+ *
+ * Bytes 0x80-0xFF are not treated as C1 controls: the terminal speaks
+ * UTF-8, so in GROUND they are printed (fed to the UTF-8 decoder) and in
+ * string states they are passed through.
+ */
+
+#include "vtparser.h"
+
+// Character classes
+enum VTClass : uint8_t {
+  C_C0,        // 0x00-0x17, 0x19, 0x1C-0x1F (except BEL)
+  C_BEL,       // 0x07 - also terminates OSC
+  C_CAN,       // 0x18, 0x1A - abort sequence
+  C_ESC,       // 0x1B
+  C_INTER,     // 0x20-0x2F intermediate
+  C_DIGIT,     // 0x30-0x39
+  C_COLON,     // 0x3A
+  C_SEMI,      // 0x3B
+  C_PRIV,      // 0x3C-0x3F private marker
+  C_CSI,       // '[' - CSI introducer after ESC
+  C_OSC,       // ']' - OSC introducer after ESC
+  C_DCS,       // 'P' - DCS introducer after ESC
+  C_SOS,       // 'X', '^', '_' - SOS/PM/APC introducers after ESC
+  C_FINAL,     // Other 0x40-0x7E
+  C_DEL,       // 0x7F
+  C_HIGH,      // 0x80-0xFF
+  C_COUNT
+};
+
+// Transition actions
+enum VTAction : uint8_t {
+  A_NONE,
+  A_PRINT,
+  A_EXECUTE,
+  A_COLLECT,
+  A_PARAM,
+  A_ESC_DISPATCH,
+  A_CSI_DISPATCH,
+  A_PUT,
+  A_OSC_PUT
+};
+
+// Table entry: high nibble = action, low nibble = next state (S_STAY = no transition)
+#define S_STAY 0x0F
+#define T(action, state) (uint8_t)(((action) << 4) | (state))
+
+// Short names for the table
+#define NONE A_NONE
+#define PRINT A_PRINT
+#define EXEC A_EXECUTE
+#define COLL A_COLLECT
+#define PARAM A_PARAM
+#define ESCD A_ESC_DISPATCH
+#define CSID A_CSI_DISPATCH
+#define PUT A_PUT
+#define OSCP A_OSC_PUT
+#define GND VT_GROUND
+#define ESC VT_ESCAPE
+#define ESI VT_ESCAPE_INTERMEDIATE
+#define CEN VT_CSI_ENTRY
+#define CPR VT_CSI_PARAM
+#define CIN VT_CSI_INTERMEDIATE
+#define CIG VT_CSI_IGNORE
+#define DEN VT_DCS_ENTRY
+#define DPR VT_DCS_PARAM
+#define DIN VT_DCS_INTERMEDIATE
+#define DPT VT_DCS_PASSTHROUGH
+#define DIG VT_DCS_IGNORE
+#define OSS VT_OSC_STRING
+#define SPA VT_SOS_PM_APC_STRING
+#define KP S_STAY
+
+static uint8_t classOf(uint8_t b) {
+  if (b >= 0x80) return C_HIGH;
+  if (b < 0x20) {
+    if (b == 0x07) return C_BEL;
+    if (b == 0x18 || b == 0x1A) return C_CAN;
+    if (b == 0x1B) return C_ESC;
+    return C_C0;
+  }
+  if (b < 0x30) return C_INTER;
+  if (b < 0x3A) return C_DIGIT;
+  if (b == 0x3A) return C_COLON;
+  if (b == 0x3B) return C_SEMI;
+  if (b < 0x40) return C_PRIV;
+  if (b == 0x7F) return C_DEL;
+  if (b == '[') return C_CSI;
+  if (b == ']') return C_OSC;
+  if (b == 'P') return C_DCS;
+  if (b == 'X' || b == '^' || b == '_') return C_SOS;
+  return C_FINAL;
+}
+
+// Byte -> class lookup, filled once in vtParserInit()
+static uint8_t classTable[256];
+static bool classTableReady = false;
+
+// State x class transition table
+static const uint8_t transitions[VT_STATE_COUNT][C_COUNT] PROGMEM = {
+  //             C0             BEL            CAN            ESC            INTER          DIGIT          COLON          SEMI           PRIV           CSI            OSC            DCS            SOS            FINAL          DEL            HIGH
+  /* GROUND  */ {T(EXEC, KP),   T(EXEC, KP),   T(EXEC, KP),   T(NONE, ESC),  T(PRINT, KP),  T(PRINT, KP),  T(PRINT, KP),  T(PRINT, KP),  T(PRINT, KP),  T(PRINT, KP),  T(PRINT, KP),  T(PRINT, KP),  T(PRINT, KP),  T(PRINT, KP),  T(NONE, KP),   T(PRINT, KP)},
+  /* ESCAPE  */ {T(EXEC, KP),   T(EXEC, KP),   T(EXEC, GND),  T(NONE, ESC),  T(COLL, ESI),  T(ESCD, GND),  T(ESCD, GND),  T(ESCD, GND),  T(ESCD, GND),  T(NONE, CEN),  T(NONE, OSS),  T(NONE, DEN),  T(NONE, SPA),  T(ESCD, GND),  T(NONE, KP),   T(NONE, GND)},
+  /* ESC_INT */ {T(EXEC, KP),   T(EXEC, KP),   T(EXEC, GND),  T(NONE, ESC),  T(COLL, KP),   T(ESCD, GND),  T(ESCD, GND),  T(ESCD, GND),  T(ESCD, GND),  T(ESCD, GND),  T(ESCD, GND),  T(ESCD, GND),  T(ESCD, GND),  T(ESCD, GND),  T(NONE, KP),   T(NONE, GND)},
+  /* CSI_ENT */ {T(EXEC, KP),   T(EXEC, KP),   T(EXEC, GND),  T(NONE, ESC),  T(COLL, CIN),  T(PARAM, CPR), T(PARAM, CPR), T(PARAM, CPR), T(COLL, CPR),  T(CSID, GND),  T(CSID, GND),  T(CSID, GND),  T(CSID, GND),  T(CSID, GND),  T(NONE, KP),   T(NONE, GND)},
+  /* CSI_PAR */ {T(EXEC, KP),   T(EXEC, KP),   T(EXEC, GND),  T(NONE, ESC),  T(COLL, CIN),  T(PARAM, KP),  T(PARAM, KP),  T(PARAM, KP),  T(NONE, CIG),  T(CSID, GND),  T(CSID, GND),  T(CSID, GND),  T(CSID, GND),  T(CSID, GND),  T(NONE, KP),   T(NONE, GND)},
+  /* CSI_INT */ {T(EXEC, KP),   T(EXEC, KP),   T(EXEC, GND),  T(NONE, ESC),  T(COLL, KP),   T(NONE, CIG),  T(NONE, CIG),  T(NONE, CIG),  T(NONE, CIG),  T(CSID, GND),  T(CSID, GND),  T(CSID, GND),  T(CSID, GND),  T(CSID, GND),  T(NONE, KP),   T(NONE, GND)},
+  /* CSI_IGN */ {T(EXEC, KP),   T(EXEC, KP),   T(EXEC, GND),  T(NONE, ESC),  T(NONE, KP),   T(NONE, KP),   T(NONE, KP),   T(NONE, KP),   T(NONE, KP),   T(NONE, GND),  T(NONE, GND),  T(NONE, GND),  T(NONE, GND),  T(NONE, GND),  T(NONE, KP),   T(NONE, GND)},
+  /* DCS_ENT */ {T(NONE, KP),   T(NONE, KP),   T(EXEC, GND),  T(NONE, ESC),  T(COLL, DIN),  T(PARAM, DPR), T(NONE, DIG),  T(PARAM, DPR), T(COLL, DPR),  T(NONE, DPT),  T(NONE, DPT),  T(NONE, DPT),  T(NONE, DPT),  T(NONE, DPT),  T(NONE, KP),   T(NONE, DIG)},
+  /* DCS_PAR */ {T(NONE, KP),   T(NONE, KP),   T(EXEC, GND),  T(NONE, ESC),  T(COLL, DIN),  T(PARAM, KP),  T(NONE, DIG),  T(PARAM, KP),  T(NONE, DIG),  T(NONE, DPT),  T(NONE, DPT),  T(NONE, DPT),  T(NONE, DPT),  T(NONE, DPT),  T(NONE, KP),   T(NONE, DIG)},
+  /* DCS_INT */ {T(NONE, KP),   T(NONE, KP),   T(EXEC, GND),  T(NONE, ESC),  T(COLL, KP),   T(NONE, DIG),  T(NONE, DIG),  T(NONE, DIG),  T(NONE, DIG),  T(NONE, DPT),  T(NONE, DPT),  T(NONE, DPT),  T(NONE, DPT),  T(NONE, DPT),  T(NONE, KP),   T(NONE, DIG)},
+  /* DCS_PT  */ {T(PUT, KP),    T(PUT, KP),    T(EXEC, GND),  T(NONE, ESC),  T(PUT, KP),    T(PUT, KP),    T(PUT, KP),    T(PUT, KP),    T(PUT, KP),    T(PUT, KP),    T(PUT, KP),    T(PUT, KP),    T(PUT, KP),    T(PUT, KP),    T(NONE, KP),   T(PUT, KP)},
+  /* DCS_IGN */ {T(NONE, KP),   T(NONE, KP),   T(EXEC, GND),  T(NONE, ESC),  T(NONE, KP),   T(NONE, KP),   T(NONE, KP),   T(NONE, KP),   T(NONE, KP),   T(NONE, KP),   T(NONE, KP),   T(NONE, KP),   T(NONE, KP),   T(NONE, KP),   T(NONE, KP),   T(NONE, KP)},
+  /* OSC     */ {T(NONE, KP),   T(NONE, GND),  T(EXEC, GND),  T(NONE, ESC),  T(OSCP, KP),   T(OSCP, KP),   T(OSCP, KP),   T(OSCP, KP),   T(OSCP, KP),   T(OSCP, KP),   T(OSCP, KP),   T(OSCP, KP),   T(OSCP, KP),   T(OSCP, KP),   T(NONE, KP),   T(OSCP, KP)},
+  /* SOS_PM  */ {T(NONE, KP),   T(NONE, KP),   T(EXEC, GND),  T(NONE, ESC),  T(NONE, KP),   T(NONE, KP),   T(NONE, KP),   T(NONE, KP),   T(NONE, KP),   T(NONE, KP),   T(NONE, KP),   T(NONE, KP),   T(NONE, KP),   T(NONE, KP),   T(NONE, KP),   T(NONE, KP)},
+};
+
+#undef NONE
+#undef PRINT
+#undef EXEC
+#undef COLL
+#undef PARAM
+#undef ESCD
+#undef CSID
+#undef PUT
+#undef OSCP
+#undef GND
+#undef ESC
+#undef ESI
+#undef CEN
+#undef CPR
+#undef CIN
+#undef CIG
+#undef DEN
+#undef DPR
+#undef DIN
+#undef DPT
+#undef DIG
+#undef OSS
+#undef SPA
+#undef KP
+
+static void clearSequence(VTParser* parser) {
+  parser->privateMarker = 0;
+  parser->intermediateCount = 0;
+  parser->paramCount = 0;
+  parser->overflow = false;
+  parser->params[0] = 0;
+}
+
+// Exit action of the state being left
+static void exitState(VTParser* parser) {
+  const VTParserHandlers* h = parser->handlers;
+  if (parser->state == VT_OSC_STRING) {
+    if (h->oscEnd) h->oscEnd();
+  } else if (parser->state == VT_DCS_PASSTHROUGH) {
+    if (h->unhook) h->unhook();
+  }
+}
+
+// Entry action of the new state
+static void enterState(VTParser* parser, uint8_t byte) {
+  const VTParserHandlers* h = parser->handlers;
+  switch (parser->state) {
+    case VT_ESCAPE:
+    case VT_CSI_ENTRY:
+    case VT_DCS_ENTRY:
+      clearSequence(parser);
+      break;
+    case VT_OSC_STRING:
+      if (h->oscStart) h->oscStart();
+      break;
+    case VT_DCS_PASSTHROUGH:
+      // The byte that caused the transition is the DCS final byte
+      if (h->hook && !parser->overflow) h->hook(parser, byte);
+      break;
+    default:
+      break;
+  }
+}
+
+static void doAction(VTParser* parser, uint8_t action, uint8_t byte) {
+  const VTParserHandlers* h = parser->handlers;
+  switch (action) {
+    case A_PRINT:
+      if (h->print) h->print(byte);
+      break;
+    
+    case A_EXECUTE:
+      if (h->execute) h->execute(byte);
+      break;
+    
+    case A_COLLECT:
+      if (byte >= 0x3C) {
+        // Private marker, only valid as first byte
+        parser->privateMarker = byte;
+      } else if (parser->intermediateCount < VT_MAX_INTERMEDIATES) {
+        parser->intermediates[parser->intermediateCount++] = byte;
+      } else {
+        parser->overflow = true;
+      }
+      break;
+    
+    case A_PARAM:
+      if (parser->paramCount == 0) {
+        parser->paramCount = 1;
+        parser->params[0] = 0;
+      }
+      if (byte == ';' || byte == ':') {
+        if (parser->paramCount < VT_MAX_PARAMS) {
+          parser->params[parser->paramCount++] = 0;
+        } else {
+          parser->overflow = true;
+        }
+      } else {
+        uint16_t* p = &parser->params[parser->paramCount - 1];
+        uint32_t value = (uint32_t)(*p) * 10 + (byte - '0');
+        *p = value > 65535 ? 65535 : value;
+      }
+      break;
+    
+    case A_ESC_DISPATCH:
+      if (h->escDispatch && !parser->overflow) h->escDispatch(parser, byte);
+      break;
+    
+    case A_CSI_DISPATCH:
+      if (h->csiDispatch && !parser->overflow) h->csiDispatch(parser, byte);
+      break;
+    
+    case A_PUT:
+      if (h->put) h->put(byte);
+      break;
+    
+    case A_OSC_PUT:
+      if (h->oscPut) h->oscPut(byte);
+      break;
+    
+    default:
+      break;
+  }
+}
+
+void vtParserInit(VTParser* parser, const VTParserHandlers* handlers) {
+  if (!classTableReady) {
+    for (int b = 0; b < 256; b++) {
+      classTable[b] = classOf(b);
+    }
+    classTableReady = true;
+  }
+  
+  parser->state = VT_GROUND;
+  parser->handlers = handlers;
+  clearSequence(parser);
+}
+
+void vtParserFeed(VTParser* parser, uint8_t byte) {
+  uint8_t entry = pgm_read_byte(&transitions[parser->state][classTable[byte]]);
+  uint8_t action = entry >> 4;
+  uint8_t next = entry & 0x0F;
+  
+  if (next == S_STAY) {
+    doAction(parser, action, byte);
+    return;
+  }
+  
+  // Transition: exit action, transition action, entry action
+  exitState(parser);
+  doAction(parser, action, byte);
+  parser->state = next;
+  enterState(parser, byte);
+}
+
+uint16_t vtParserParam(const VTParser* parser, int index, uint16_t defaultValue) {
+  if (index >= parser->paramCount || parser->params[index] == 0) {
+    return defaultValue;
+  }
+  return parser->params[index];
+}
@@ -0,0 +1,78 @@
+/*
+ * vtparser.h - Table-driven VT500-class escape sequence parser
+ *
+ * Byte-at-a-time state machine after Paul Williams' DEC ANSI parser model.
+ * Parameters are accumulated as numbers while parsing, no sequence text
+ * is buffered.
+ */
+
+#ifndef VTPARSER_H
+#define VTPARSER_H
+
+#include <Arduino.h>
+
+#define VT_MAX_PARAMS 16
+#define VT_MAX_INTERMEDIATES 2
+
+// Parser states
+enum VTState : uint8_t {
+  VT_GROUND,
+  VT_ESCAPE,
+  VT_ESCAPE_INTERMEDIATE,
+  VT_CSI_ENTRY,
+  VT_CSI_PARAM,
+  VT_CSI_INTERMEDIATE,
+  VT_CSI_IGNORE,
+  VT_DCS_ENTRY,
+  VT_DCS_PARAM,
+  VT_DCS_INTERMEDIATE,
+  VT_DCS_PASSTHROUGH,
+  VT_DCS_IGNORE,
+  VT_OSC_STRING,
+  VT_SOS_PM_APC_STRING,
+  VT_STATE_COUNT
+};
+
+struct VTParser;
+
+// Action handlers - any of them may be nullptr
+struct VTParserHandlers {
+  void (*print)(uint8_t byte);                           // Printable byte (UTF-8 bytes included)
+  void (*execute)(uint8_t byte);                         // C0 control
+  void (*escDispatch)(const VTParser* parser, uint8_t finalByte);
+  void (*csiDispatch)(const VTParser* parser, uint8_t finalByte);
+  void (*hook)(const VTParser* parser, uint8_t finalByte); // DCS start
+  void (*put)(uint8_t byte);                             // DCS data
+  void (*unhook)();                                      // DCS end
+  void (*oscStart)();
+  void (*oscPut)(uint8_t byte);
+  void (*oscEnd)();
+};
+
+// Parser state
+struct VTParser {
+  uint8_t state;
+  uint8_t privateMarker;                          // '?', '>', '<', '=' or 0
+  uint8_t intermediates[VT_MAX_INTERMEDIATES];
+  uint8_t intermediateCount;
+  uint8_t paramCount;
+  bool overflow;                                  // Too many params/intermediates, sequence is dropped
+  uint16_t params[VT_MAX_PARAMS];
+  const VTParserHandlers* handlers;
+};
+
+// Initialize parser
+void vtParserInit(VTParser* parser, const VTParserHandlers* handlers);
+
+// Feed one byte
+void vtParserFeed(VTParser* parser, uint8_t byte);
+
+// Check if parser is outside of any escape sequence
+inline bool vtParserInGround(const VTParser* parser) {
+  return parser->state == VT_GROUND;
+}
+
+// Get parameter, returns defaultValue if missing or 0
+uint16_t vtParserParam(const VTParser* parser, int index, uint16_t defaultValue);
+
+#endif